@@ -0,0 +1,58 @@
+#include <stdint.h>
+#include <string.h>
+
+/* Backing store for the fixed offset regions when the DSP core is built with
+ * the MoonBit C backend. Sized to match heap-start-address in
+ * src/moon.pkg.json, which bounds every region in contracts/memory-layout.json;
+ * scripts/gen-memory-layout.js keeps both in sync. */
+#ifndef MOONVST_NATIVE_ARENA_BYTES
+#define MOONVST_NATIVE_ARENA_BYTES 2359296
+#endif
+
+#define MOONVST_NATIVE_PAGE_BYTES 65536
+
+#if defined(_MSC_VER)
+__declspec(align(64)) static uint8_t moonvst_native_arena[MOONVST_NATIVE_ARENA_BYTES];
+#else
+static uint8_t moonvst_native_arena[MOONVST_NATIVE_ARENA_BYTES] __attribute__((aligned(64)));
+#endif
+
+float moonvst_native_load_f32(int32_t ptr) {
+  float value;
+  memcpy(&value, moonvst_native_arena + ptr, sizeof(value));
+  return value;
+}
+
+void moonvst_native_store_f32(int32_t ptr, float value) {
+  memcpy(moonvst_native_arena + ptr, &value, sizeof(value));
+}
+
+int32_t moonvst_native_load_u8(int32_t ptr) {
+  return moonvst_native_arena[ptr];
+}
+
+void moonvst_native_store_u8(int32_t ptr, int32_t value) {
+  moonvst_native_arena[ptr] = (uint8_t)value;
+}
+
+int32_t moonvst_native_load_i32(int32_t ptr) {
+  int32_t value;
+  memcpy(&value, moonvst_native_arena + ptr, sizeof(value));
+  return value;
+}
+
+void moonvst_native_store_i32(int32_t ptr, int32_t value) {
+  memcpy(moonvst_native_arena + ptr, &value, sizeof(value));
+}
+
+int32_t moonvst_native_memory_pages(void) {
+  return MOONVST_NATIVE_ARENA_BYTES / MOONVST_NATIVE_PAGE_BYTES;
+}
+
+uint8_t* moonvst_native_arena_base(void) {
+  return moonvst_native_arena;
+}
+
+int32_t moonvst_native_arena_size(void) {
+  return MOONVST_NATIVE_ARENA_BYTES;
+}
@@ -2,12 +2,18 @@
  * MoonVST AudioWorklet Processor
  * Runs WASM DSP in the audio thread via AudioWorklet.
  */
+const now = globalThis.performance && typeof globalThis.performance.now === 'function'
+  ? () => globalThis.performance.now()
+  : () => Date.now()
+
 class MoonVSTProcessor extends AudioWorkletProcessor {
   constructor() {
     super()
     this.wasmInstance = null
+    this.wasmExports = null
     this.wasmMemory = null
     this.ready = false
+    this.inputChannels = 0
     this.levelPeak = 0
     this.levelSampleCounter = 0
     this.levelEmitIntervalSamples = Math.max(1, Math.floor(sampleRate * 0.05))
@@ -15,11 +21,29 @@ class MoonVSTProcessor extends AudioWorkletProcessor {
     this.cpuLoadSampleCounter = 0
     this.cpuEmitIntervalSamples = Math.max(1, Math.floor(sampleRate * 0.05))
 
-    // Memory offsets (must match packages/dsp-core/src/utils/constants.mbt)
-    this.INPUT_LEFT_OFFSET = 0x10000
-    this.INPUT_RIGHT_OFFSET = 0x20000
-    this.OUTPUT_LEFT_OFFSET = 0x30000
-    this.OUTPUT_RIGHT_OFFSET = 0x40000
+    // AUTO-GENERATED by scripts/gen-memory-layout.js (next 3 lines). DO NOT EDIT.
+    this.CHANNEL_STRIDE_BYTES = 0x10000
+    this.INPUT_BASE_OFFSET = 0x10000
+    this.OUTPUT_BASE_OFFSET = 0xD0000
+
+    // Views over the I/O regions of linear memory. A memory.grow detaches the
+    // old ArrayBuffer, so they are rebuilt only when the buffer identity or the
+    // quantum size changes; the steady state allocates nothing per quantum.
+    this.viewBuffer = null
+    this.viewSamples = 0
+    this.inLView = null
+    this.inRView = null
+    this.outLView = null
+    this.outRView = null
+
+    // Optional SharedArrayBuffer transport (layout in WebRuntime.ts
+    // createSharedParamBank). When present, parameter writes arrive through
+    // the dirty bitmap and telemetry leaves through the shared block, so
+    // neither direction posts messages per change.
+    this.sharedDirty = null
+    this.sharedPending = null
+    this.sharedValues = null
+    this.sharedTelemetry = null
 
     this.port.onmessage = (e) => this.handleMessage(e.data)
   }
@@ -27,13 +51,20 @@ class MoonVSTProcessor extends AudioWorkletProcessor {
   async handleMessage(data) {
     if (data.type === 'loadWasm') {
       try {
-        const module = await WebAssembly.compile(data.wasmBytes)
+        // The main thread normally transfers an already compiled Module;
+        // raw bytes are still accepted for older callers.
+        const module = data.wasmModule ?? await WebAssembly.compile(data.wasmBytes)
         const instance = await WebAssembly.instantiate(module)
         this.wasmInstance = instance
+        this.wasmExports = instance.exports
         this.wasmMemory = instance.exports.memory
+        if (data.sharedParams) {
+          this.attachSharedParams(data.sharedParams)
+        }
         instance.exports.dsp_init()
         if (typeof instance.exports.dsp_prepare === 'function') {
-          instance.exports.dsp_prepare(sampleRate)
+          // Render quanta are 128 frames.
+          instance.exports.dsp_prepare(sampleRate, 128)
         }
         this.ready = true
         this.port.postMessage({ type: 'ready' })
@@ -45,84 +76,130 @@ class MoonVSTProcessor extends AudioWorkletProcessor {
     }
   }
 
+  attachSharedParams(bank) {
+    const { buffer, paramCount, dirtyWords } = bank
+    const valuesOffset = dirtyWords * 4
+    const telemetryOffset = valuesOffset + paramCount * 4
+    this.sharedDirty = new Int32Array(buffer, 0, dirtyWords)
+    this.sharedPending = new Int32Array(dirtyWords)
+    this.sharedValues = new Float32Array(buffer, valuesOffset, paramCount)
+    this.sharedTelemetry = new Float32Array(buffer, telemetryOffset, 2)
+  }
+
+  drainSharedParams() {
+    const dirty = this.sharedDirty
+    const pending = this.sharedPending
+    const values = this.sharedValues
+    const setParam = this.wasmExports.set_param
+    // Swap the words out from the highest down. A writer marks a parameter
+    // before the revision parameter above it that publishes it, so once the
+    // revision's bit is taken every write it covers is already marked in a
+    // word still to be swapped. Clearing before reading values means a write
+    // racing with this drain re-marks its bit and is picked up next quantum
+    // instead of being lost.
+    for (let word = dirty.length - 1; word >= 0; word--) {
+      pending[word] = dirty[word] === 0 ? 0 : Atomics.exchange(dirty, word, 0)
+    }
+    // Apply in ascending order, so a revision lands after what it covers.
+    for (let word = 0; word < pending.length; word++) {
+      let bits = pending[word]
+      while (bits !== 0) {
+        const bit = 31 - Math.clz32(bits & -bits)
+        bits &= bits - 1
+        const index = word * 32 + bit
+        if (index < values.length) setParam(index, values[index])
+      }
+    }
+  }
+
+  ensureViews(numSamples) {
+    const buffer = this.wasmMemory.buffer
+    if (buffer === this.viewBuffer && numSamples === this.viewSamples) return
+
+    this.viewBuffer = buffer
+    this.viewSamples = numSamples
+    // The worklet is stereo: channels 0 and 1 of the planar I/O blocks.
+    const stride = this.CHANNEL_STRIDE_BYTES
+    this.inLView = new Float32Array(buffer, this.INPUT_BASE_OFFSET, numSamples)
+    this.inRView = new Float32Array(buffer, this.INPUT_BASE_OFFSET + stride, numSamples)
+    this.outLView = new Float32Array(buffer, this.OUTPUT_BASE_OFFSET, numSamples)
+    this.outRView = new Float32Array(buffer, this.OUTPUT_BASE_OFFSET + stride, numSamples)
+  }
+
   process(inputs, outputs) {
-    if (!this.ready || !this.wasmInstance) return true
+    if (!this.ready || !this.wasmExports) return true
 
     const input = inputs[0]
     const output = outputs[0]
     const numSamples = output[0]?.length ?? 0
-    const now = globalThis.performance && typeof globalThis.performance.now === 'function'
-      ? () => globalThis.performance.now()
-      : () => Date.now()
 
     if (numSamples === 0) return true
     const startMs = now()
+    const exports = this.wasmExports
+    if (this.sharedDirty) this.drainSharedParams()
 
-    const mem = new Float32Array(this.wasmMemory.buffer)
-    const bytesPerFloat = 4
-
-    // Copy input to WASM memory
-    const inLOffset = this.INPUT_LEFT_OFFSET / bytesPerFloat
-    const inROffset = this.INPUT_RIGHT_OFFSET / bytesPerFloat
-    if (input[0]) {
-      mem.set(input[0], inLOffset)
-    } else {
-      mem.fill(0, inLOffset, inLOffset + numSamples)
+    // Copy input into the WASM input regions
+    this.ensureViews(numSamples)
+    // A mono source lets the DSP run its single-channel path and fan out to
+    // both outputs. The left input is still mirrored into the right region
+    // for modules that predate dsp_set_channel_layout.
+    const inL = input[0]
+    const inR = input[1]
+    const inputChannels = inR ? 2 : 1
+    if (inputChannels !== this.inputChannels && typeof exports.dsp_set_channel_layout === 'function') {
+      exports.dsp_set_channel_layout(inputChannels, 2)
+      this.inputChannels = inputChannels
     }
-    if (input[1]) {
-      mem.set(input[1], inROffset)
-    } else if (input[0]) {
-      mem.set(input[0], inROffset)
+    if (inL) {
+      this.inLView.set(inL)
+      this.inRView.set(inR ?? inL)
     } else {
-      mem.fill(0, inROffset, inROffset + numSamples)
+      this.inLView.fill(0)
+      this.inRView.fill(0)
     }
 
     // Process
-    this.wasmInstance.exports.process_block(numSamples)
-    const processMs = now() - startMs
-    const blockMs = (numSamples / sampleRate) * 1000
-    if (blockMs > 0) {
-      const blockLoad = Math.max(0, Math.min(1, processMs / blockMs))
-      this.cpuLoadSmoothed = this.cpuLoadSmoothed * 0.85 + blockLoad * 0.15
-    }
+    exports.process_block(numSamples)
 
-    // Copy output from WASM memory
-    const outLOffset = this.OUTPUT_LEFT_OFFSET / bytesPerFloat
-    const outROffset = this.OUTPUT_RIGHT_OFFSET / bytesPerFloat
+    // The DSP may have grown memory; views must track the live buffer.
+    this.ensureViews(numSamples)
+    const blockPeak = exports.get_output_peak(numSamples)
 
     if (output[0]) {
-      output[0].set(mem.subarray(outLOffset, outLOffset + numSamples))
+      output[0].set(this.outLView)
     }
     if (output[1]) {
-      output[1].set(mem.subarray(outROffset, outROffset + numSamples))
+      output[1].set(this.outRView)
     }
 
-    let blockPeak = 0
-    const outL = output[0]
-    const outR = output[1]
-    if (outL) {
-      for (let i = 0; i < outL.length; i++) {
-        const v = Math.abs(outL[i])
-        if (v > blockPeak) blockPeak = v
-      }
-    }
-    if (outR) {
-      for (let i = 0; i < outR.length; i++) {
-        const v = Math.abs(outR[i])
-        if (v > blockPeak) blockPeak = v
-      }
+    const processMs = now() - startMs
+    const blockMs = (numSamples / sampleRate) * 1000
+    if (blockMs > 0) {
+      const blockLoad = Math.max(0, Math.min(1, processMs / blockMs))
+      this.cpuLoadSmoothed = this.cpuLoadSmoothed * 0.85 + blockLoad * 0.15
     }
 
     if (blockPeak > this.levelPeak) this.levelPeak = blockPeak
     this.levelSampleCounter += numSamples
     this.cpuLoadSampleCounter += numSamples
+    const telemetry = this.sharedTelemetry
     if (this.levelSampleCounter >= this.levelEmitIntervalSamples) {
-      this.port.postMessage({ type: 'level', value: Math.min(1, this.levelPeak) })
+      const level = Math.min(1, this.levelPeak)
+      if (telemetry) {
+        telemetry[0] = level
+      } else {
+        this.port.postMessage({ type: 'level', value: level })
+      }
       this.levelPeak = 0
       this.levelSampleCounter = 0
     }
     if (this.cpuLoadSampleCounter >= this.cpuEmitIntervalSamples) {
-      this.port.postMessage({ type: 'cpuLoad', value: Math.max(0, Math.min(1, this.cpuLoadSmoothed)) })
+      const cpuLoad = Math.max(0, Math.min(1, this.cpuLoadSmoothed))
+      if (telemetry) {
+        telemetry[1] = cpuLoad
+      } else {
+        this.port.postMessage({ type: 'cpuLoad', value: cpuLoad })
+      }
       this.cpuLoadSampleCounter = 0
     }
 
@@ -1,4 +1,4 @@
-import type { AudioRuntime, ParamInfo } from './types'
+import type { AudioRuntime, ParamInfo, RuntimeDspHealth, RuntimeMemoryUsage } from './types'
 
 declare global {
   interface Window {
@@ -19,6 +19,39 @@ declare global {
   }
 }
 
+const PARAM_BATCH_EVENT_ID = 'moonvst:params'
+const TELEMETRY_EVENT_ID = 'moonvst:telemetry'
+const SPECTRUM_EVENT_ID = 'moonvst:spectrum'
+
+// Spectrum frames arrive as base64 so the bridge carries one short string.
+function parseSpectrum(raw: unknown): Uint8Array | null {
+  if (typeof raw !== 'string' || raw.length === 0) return null
+  try {
+    const bytes = atob(raw)
+    const bands = new Uint8Array(bytes.length)
+    for (let i = 0; i < bytes.length; i++) bands[i] = bytes.charCodeAt(i)
+    return bands
+  } catch {
+    return null
+  }
+}
+
+function parseMemoryUsage(raw: any): RuntimeMemoryUsage | null {
+  const linearMemoryBytes = Number(raw?.linearMemoryBytes)
+  const residentBytes = Number(raw?.residentBytes)
+  if (!Number.isFinite(linearMemoryBytes) || !Number.isFinite(residentBytes)) return null
+  if (linearMemoryBytes <= 0 || residentBytes <= 0) return null
+  return { linearMemoryBytes, residentBytes }
+}
+
+function parseDspHealth(raw: any): RuntimeDspHealth | null {
+  const traps = Number(raw?.traps)
+  const overruns = Number(raw?.overruns)
+  const recoveries = Number(raw?.recoveries)
+  if (!Number.isFinite(traps) || !Number.isFinite(overruns) || !Number.isFinite(recoveries)) return null
+  return { traps, overruns, recoveries, faulted: Boolean(raw?.faulted) }
+}
+
 export async function createJuceRuntime(): Promise<AudioRuntime> {
   type SliderState = {
     getValue(): number
@@ -27,9 +60,17 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
     removeListener(cb: () => void): void
   }
 
+  type EventBridge = {
+    addEventListener(eventId: string, listener: (event: any) => void): any
+    emitEvent(eventId: string, payload: any): void
+  }
+
   type JuceBridgeCompat = {
     getNativeFunction(name: string): (...args: unknown[]) => Promise<unknown>
-    getSliderState(name: string): SliderState
+    // Per-parameter relay shape (legacy bridges without an event backend).
+    getSliderState?(name: string): SliderState
+    // Present when the plugin can push batched "moonvst:params" events.
+    events?: EventBridge
   }
 
   const withTimeout = async <T>(promise: Promise<T>, label: string, timeoutMs = 4000): Promise<T> => {
@@ -63,15 +104,18 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
         && typeof candidate.addEventListener === 'function'
         && typeof candidate.emitEvent === 'function'
       ) {
-        return candidate as { addEventListener(eventId: string, listener: (event: any) => void): any; emitEvent(eventId: string, payload: any): void }
+        return candidate as EventBridge
       }
       return undefined
     }
 
+    const events = asEventBridge(raw.backend)
+
     if (typeof raw.getNativeFunction === 'function' && typeof raw.getSliderState === 'function') {
       return {
         getNativeFunction: raw.getNativeFunction.bind(raw),
         getSliderState: raw.getSliderState.bind(raw),
+        events,
       }
     }
 
@@ -80,7 +124,27 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
     if (typeof raw.getNativeFunction === 'function') {
       const getNativeFunction = raw.getNativeFunction.bind(raw)
       const sliderCache = new Map<string, SliderState>()
-      const pollers = new Map<string, ReturnType<typeof setInterval>>()
+      // One shared poll loop for every slider that currently has listeners.
+      const polled = new Map<string, () => Promise<void>>()
+      let poller: ReturnType<typeof setInterval> | undefined
+      const startPolling = (name: string, poll: () => Promise<void>) => {
+        polled.set(name, poll)
+        void poll()
+        if (poller === undefined) {
+          poller = setInterval(() => {
+            polled.forEach((pollOne) => {
+              void pollOne()
+            })
+          }, 100)
+        }
+      }
+      const stopPolling = (name: string) => {
+        polled.delete(name)
+        if (polled.size === 0 && poller !== undefined) {
+          clearInterval(poller)
+          poller = undefined
+        }
+      }
       const parseIndex = (name: string) => {
         const m = /^param_(\d+)$/.exec(name)
         return m ? Number(m[1]) : -1
@@ -116,20 +180,11 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
           },
           addListener: (cb: () => void) => {
             listeners.add(cb)
-            if (!pollers.has(name)) {
-              void notifyIfChanged()
-              pollers.set(name, setInterval(() => {
-                void notifyIfChanged()
-              }, 100))
-            }
+            if (!polled.has(name)) startPolling(name, notifyIfChanged)
           },
           removeListener: (cb: () => void) => {
             listeners.delete(cb)
-            if (listeners.size === 0) {
-              const id = pollers.get(name)
-              if (id) clearInterval(id)
-              pollers.delete(name)
-            }
+            if (listeners.size === 0) stopPolling(name)
           },
         }
 
@@ -137,10 +192,10 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
         return state
       }
 
-      return { getNativeFunction, getSliderState }
+      return { getNativeFunction, getSliderState, events }
     }
 
-    const backend = asEventBridge(raw.backend) ?? asEventBridge(raw as any)
+    const backend = events ?? asEventBridge(raw as any)
     if (!backend) {
       const keys = Object.keys(raw as Record<string, unknown>).join(',')
       throw new Error(`Unsupported JUCE bridge shape (keys: ${keys})`)
@@ -156,42 +211,6 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
       resolve(event?.result)
     })
 
-    const sliderCache = new Map<string, SliderState>()
-    const getSliderState = (name: string): SliderState => {
-      const existing = sliderCache.get(name)
-      if (existing) return existing
-
-      const eventId = `__juce__slider${name}`
-      let value = 0
-      const listeners = new Set<() => void>()
-
-      backend.addEventListener(eventId, (event: any) => {
-        if (event?.eventType === 'valueChanged') {
-          value = Number(event.value ?? 0)
-          listeners.forEach((cb) => cb())
-        }
-      })
-
-      backend.emitEvent(eventId, { eventType: 'requestInitialUpdate' })
-
-      const state: SliderState = {
-        getValue: () => value,
-        setValue: (v: number) => {
-          value = v
-          backend.emitEvent(eventId, { eventType: 'valueChanged', value: v })
-        },
-        addListener: (cb: () => void) => {
-          listeners.add(cb)
-        },
-        removeListener: (cb: () => void) => {
-          listeners.delete(cb)
-        },
-      }
-
-      sliderCache.set(name, state)
-      return state
-    }
-
     const getNativeFunction = (name: string) => (...args: unknown[]) =>
       new Promise<unknown>((resolve) => {
         const promiseId = nextPromiseId++
@@ -199,7 +218,7 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
         backend.emitEvent('__juce__invoke', { name, params: args, resultId: promiseId })
       })
 
-    return { getNativeFunction, getSliderState }
+    return { getNativeFunction, events: backend }
   }
 
   const bridge = adaptBridge(juce)
@@ -217,6 +236,8 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
   }
   const getCpuLoadNative = getOptionalNative('getCpuLoad')
   const getLatencyMsNative = getOptionalNative('getLatencyMs')
+  const getMemoryUsageNative = getOptionalNative('getMemoryUsage')
+  const getDspHealthNative = getOptionalNative('getDspHealth')
   const invokeNative = (name: string, ...args: unknown[]) => bridge.getNativeFunction(name)(...args)
 
   // Fetch all parameter info at init
@@ -247,9 +268,80 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
   }
 
   const getRelayName = (index: number) => `param_${index}`
+
+  // Batched parameter sync: subscribe lazily to the indices the UI reads and
+  // receive all changes for a frame in one event.
+  const batchedParams = (() => {
+    const events = bridge.events
+    if (!events) return null
+
+    const subscribeParams = bridge.getNativeFunction('subscribeParams')
+    const values = new Map<number, number>()
+    const listeners = new Map<number, Set<(v: number) => void>>()
+    const subscribed = new Set<number>()
+    let pending: number[] = []
+
+    const apply = (entries: unknown) => {
+      if (!Array.isArray(entries)) return
+      for (const entry of entries) {
+        if (!Array.isArray(entry)) continue
+        const index = Number(entry[0])
+        const value = Number(entry[1])
+        if (!Number.isInteger(index) || !Number.isFinite(value)) continue
+        values.set(index, value)
+        listeners.get(index)?.forEach((cb) => cb(value))
+      }
+    }
+
+    events.addEventListener(PARAM_BATCH_EVENT_ID, apply)
+
+    const ensureSubscribed = (index: number) => {
+      if (subscribed.has(index)) return
+      subscribed.add(index)
+      pending.push(index)
+      if (pending.length > 1) return
+      queueMicrotask(() => {
+        const batch = pending
+        pending = []
+        subscribeParams(batch).then(apply, () => {
+          // Ignore transient bridge failures; values stay at their defaults.
+        })
+      })
+    }
+
+    return {
+      get(index: number) {
+        ensureSubscribed(index)
+        return values.get(index) ?? params[index]?.defaultValue ?? 0
+      },
+      set(index: number, value: number) {
+        values.set(index, value)
+      },
+      on(index: number, cb: (v: number) => void) {
+        ensureSubscribed(index)
+        let set = listeners.get(index)
+        if (!set) {
+          set = new Set()
+          listeners.set(index, set)
+        }
+        set.add(cb)
+        return () => {
+          set?.delete(cb)
+        }
+      },
+    }
+  })()
+
+  const getSliderState = (index: number) => {
+    if (!bridge.getSliderState) throw new Error('JUCE bridge has no parameter relay')
+    return bridge.getSliderState(getRelayName(index))
+  }
   let currentLevel = 0
   let currentCpuLoad: number | null = null
   let currentLatencyMs: number | null = null
+  let currentMemoryUsage: RuntimeMemoryUsage | null = null
+  let currentDspHealth: RuntimeDspHealth | null = null
+  let currentSpectrum: Uint8Array | null = null
   const pollLevel = async () => {
     try {
       const raw = Number(await (getLevelNative() as Promise<number>))
@@ -279,13 +371,47 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
         // Ignore transient bridge failures.
       }
     }
+    if (getMemoryUsageNative) {
+      try {
+        currentMemoryUsage = parseMemoryUsage(await getMemoryUsageNative()) ?? currentMemoryUsage
+      } catch {
+        // Ignore transient bridge failures.
+      }
+    }
+    if (getDspHealthNative) {
+      try {
+        currentDspHealth = parseDspHealth(await getDspHealthNative()) ?? currentDspHealth
+      } catch {
+        // Ignore transient bridge failures.
+      }
+    }
   }
   void pollLevel()
   void pollMetrics()
-  const levelTimer = setInterval(() => {
-    void pollLevel()
-    void pollMetrics()
-  }, 50)
+
+  // The editor pushes one telemetry event per display frame while visible;
+  // bridges without an event backend fall back to polling.
+  let levelTimer: ReturnType<typeof setInterval> | undefined
+  if (bridge.events) {
+    bridge.events.addEventListener(TELEMETRY_EVENT_ID, (event: any) => {
+      const level = Number(event?.level)
+      if (Number.isFinite(level)) currentLevel = Math.max(0, Math.min(1, level))
+      const cpuLoad = Number(event?.cpuLoad)
+      if (Number.isFinite(cpuLoad)) currentCpuLoad = Math.max(0, Math.min(1, cpuLoad))
+      const latencyMs = Number(event?.latencyMs)
+      if (Number.isFinite(latencyMs) && latencyMs >= 0) currentLatencyMs = latencyMs
+      currentMemoryUsage = parseMemoryUsage(event) ?? currentMemoryUsage
+      currentDspHealth = parseDspHealth(event) ?? currentDspHealth
+    })
+    bridge.events.addEventListener(SPECTRUM_EVENT_ID, (event: unknown) => {
+      currentSpectrum = parseSpectrum(event) ?? currentSpectrum
+    })
+  } else {
+    levelTimer = setInterval(() => {
+      void pollLevel()
+      void pollMetrics()
+    }, 50)
+  }
 
   return {
     type: 'juce',
@@ -295,14 +421,15 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
     },
 
     setParam(index: number, value: number) {
+      batchedParams?.set(index, value)
       setParamNative(index, value)
     },
 
     getParam(index: number) {
       const p = params[index]
       if (!p) return 0
-      const slider = bridge.getSliderState(getRelayName(p.index))
-      return slider.getValue()
+      if (batchedParams) return batchedParams.get(p.index)
+      return getSliderState(p.index).getValue()
     },
 
     getLevel() {
@@ -317,11 +444,24 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
       return currentLatencyMs
     },
 
+    getMemoryUsage() {
+      return currentMemoryUsage
+    },
+
+    getDspHealth() {
+      return currentDspHealth
+    },
+
+    getSpectrum() {
+      return currentSpectrum
+    },
+
     onParamChange(index: number, cb: (v: number) => void) {
       const p = params[index]
       if (!p) return () => {}
+      if (batchedParams) return batchedParams.on(p.index, cb)
 
-      const slider = bridge.getSliderState(getRelayName(p.index))
+      const slider = getSliderState(p.index)
       const listener = () => cb(slider.getValue())
       slider.addListener(listener)
       return () => slider.removeListener(listener)
@@ -332,7 +472,7 @@ export async function createJuceRuntime(): Promise<AudioRuntime> {
     },
 
     dispose() {
-      clearInterval(levelTimer)
+      if (levelTimer !== undefined) clearInterval(levelTimer)
     },
   }
 }
@@ -25,6 +25,8 @@ describe('createJuceRuntime', () => {
       if (name === 'getLevel') return async () => 0.4
       if (name === 'getCpuLoad') return async () => 0.33
       if (name === 'getLatencyMs') return async () => 7.25
+      if (name === 'getMemoryUsage') return async () => ({ linearMemoryBytes: 2097152, residentBytes: 2293760 })
+      if (name === 'getDspHealth') return async () => ({ traps: 1, overruns: 0, recoveries: 1, faulted: false })
       if (name === 'customNative') return customNative
       return async () => 0
     }
@@ -63,6 +65,8 @@ describe('createJuceRuntime', () => {
     await vi.waitFor(() => {
       expect(runtime.getCpuLoad?.()).toBeCloseTo(0.33, 5)
       expect(runtime.getLatencyMs?.()).toBeCloseTo(7.25, 5)
+      expect(runtime.getMemoryUsage?.()).toEqual({ linearMemoryBytes: 2097152, residentBytes: 2293760 })
+      expect(runtime.getDspHealth?.()).toEqual({ traps: 1, overruns: 0, recoveries: 1, faulted: false })
     })
     runtime.dispose()
   })
@@ -99,6 +103,99 @@ describe('createJuceRuntime', () => {
     expect(runtime.getParams()).toHaveLength(1)
     expect(runtime.getCpuLoad?.()).toBeNull()
     expect(runtime.getLatencyMs?.()).toBeNull()
+    expect(runtime.getMemoryUsage?.()).toBeNull()
+    expect(runtime.getDspHealth?.()).toBeNull()
+    runtime.dispose()
+  })
+
+  test('syncs parameters and telemetry through pushed events on the event backend', async () => {
+    const eventListeners = new Map<string, Set<(event: any) => void>>()
+    const subscribeCalls: number[][] = []
+    const setParamCalls: Array<[number, number]> = []
+
+    const dispatch = (eventId: string, payload: unknown) => {
+      eventListeners.get(eventId)?.forEach((listener) => listener(payload))
+    }
+
+    const invoke = (name: string, params: unknown[]): unknown => {
+      if (name === 'getParamCount') return 2
+      if (name === 'getParamInfo') {
+        const index = Number(params[0])
+        return { name: `p${index}`, min: 0, max: 1, defaultValue: 0.1 * (index + 1), index }
+      }
+      if (name === 'subscribeParams') {
+        const indices = params[0] as number[]
+        subscribeCalls.push(indices)
+        return indices.map((index) => [index, 0.5 + index * 0.1])
+      }
+      if (name === 'setParam') {
+        setParamCalls.push([Number(params[0]), Number(params[1])])
+        return undefined
+      }
+      return 0
+    }
+
+    ;(window as Window & { __JUCE__?: unknown }).__JUCE__ = {
+      backend: {
+        addEventListener: (eventId: string, listener: (event: any) => void) => {
+          const set = eventListeners.get(eventId) ?? new Set()
+          set.add(listener)
+          eventListeners.set(eventId, set)
+          return [eventId, listener]
+        },
+        emitEvent: (eventId: string, payload: any) => {
+          if (eventId !== '__juce__invoke') return
+          const result = invoke(payload.name, payload.params)
+          queueMicrotask(() => dispatch('__juce__complete', { promiseId: payload.resultId, result }))
+        },
+      },
+    }
+
+    const runtime = await createJuceRuntime()
+    expect(runtime.getParams()).toHaveLength(2)
+
+    expect(runtime.getParam(0)).toBeCloseTo(0.1, 5)
+    const onChange = vi.fn()
+    const off = runtime.onParamChange(1, onChange)
+
+    await vi.waitFor(() => {
+      expect(runtime.getParam(0)).toBeCloseTo(0.5, 5)
+    })
+    expect(subscribeCalls).toEqual([[0, 1]])
+    expect(onChange).toHaveBeenCalledWith(0.6)
+
+    dispatch('moonvst:params', [[1, 0.9], [0, 0.25]])
+    expect(onChange).toHaveBeenLastCalledWith(0.9)
+    expect(runtime.getParam(0)).toBe(0.25)
+
+    runtime.setParam(0, 0.75)
+    expect(runtime.getParam(0)).toBe(0.75)
+    expect(setParamCalls).toContainEqual([0, 0.75])
+
+    off()
+    dispatch('moonvst:params', [[1, 0.1]])
+    expect(onChange).toHaveBeenCalledTimes(2)
+
+    dispatch('moonvst:telemetry', {
+      level: 0.42,
+      cpuLoad: 0.18,
+      latencyMs: 2.5,
+      linearMemoryBytes: 1048576,
+      residentBytes: 1245184,
+      traps: 0,
+      overruns: 2,
+      recoveries: 1,
+      faulted: true,
+    })
+    expect(runtime.getLevel()).toBeCloseTo(0.42, 5)
+    expect(runtime.getCpuLoad?.()).toBeCloseTo(0.18, 5)
+    expect(runtime.getLatencyMs?.()).toBeCloseTo(2.5, 5)
+    expect(runtime.getMemoryUsage?.()).toEqual({ linearMemoryBytes: 1048576, residentBytes: 1245184 })
+    expect(runtime.getDspHealth?.()).toEqual({ traps: 0, overruns: 2, recoveries: 1, faulted: true })
+
+    expect(runtime.getSpectrum?.()).toBeNull()
+    dispatch('moonvst:spectrum', btoa(String.fromCharCode(0, 128, 255)))
+    expect(Array.from(runtime.getSpectrum?.() ?? [])).toEqual([0, 128, 255])
     runtime.dispose()
   })
 })
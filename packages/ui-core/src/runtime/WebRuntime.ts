@@ -1,4 +1,5 @@
-import type { ParamInfo, WebAudioRuntime } from './types'
+import type { ParamInfo, RuntimeStartupTiming, WebAudioRuntime } from './types'
+import { compileDspModule } from '../utils/wasmModuleLoader'
 
 interface WasmExports {
   memory: WebAssembly.Memory
@@ -14,28 +15,80 @@ interface WasmExports {
   get_param(index: number): number
 }
 
+/**
+ * Parameter bank shared with the AudioWorklet when the page is cross-origin
+ * isolated. Layout (all 4-byte slots, mirrored in public/worklet/processor.js):
+ *   [0, dirtyWords)            Int32 dirty bitmap, one bit per parameter
+ *   [dirtyWords, +paramCount)  Float32 latest value per parameter
+ *   [.., +2)                   Float32 telemetry: level, cpuLoad
+ */
+export interface SharedParamBank {
+  buffer: SharedArrayBuffer
+  paramCount: number
+  dirtyWords: number
+  dirty: Int32Array
+  values: Float32Array
+  telemetry: Float32Array
+}
+
+const TELEMETRY_SLOTS = 2
+
+export function createSharedParamBank(paramCount: number): SharedParamBank | null {
+  if (typeof SharedArrayBuffer !== 'function' || !globalThis.crossOriginIsolated) {
+    return null
+  }
+  const dirtyWords = Math.max(1, Math.ceil(paramCount / 32))
+  const buffer = new SharedArrayBuffer((dirtyWords + paramCount + TELEMETRY_SLOTS) * 4)
+  const valuesOffset = dirtyWords * 4
+  return {
+    buffer,
+    paramCount,
+    dirtyWords,
+    dirty: new Int32Array(buffer, 0, dirtyWords),
+    values: new Float32Array(buffer, valuesOffset, paramCount),
+    telemetry: new Float32Array(buffer, valuesOffset + paramCount * 4, TELEMETRY_SLOTS),
+  }
+}
+
+export function writeSharedParam(bank: SharedParamBank, index: number, value: number): void {
+  if (index < 0 || index >= bank.paramCount) return
+  bank.values[index] = value
+  // Atomics.or is sequentially consistent, so the value store above is
+  // visible to the worklet before it observes the dirty bit.
+  Atomics.or(bank.dirty, index >> 5, 1 << (index & 31))
+}
+
 export function resolveRuntimeAssetPath(assetPath: string, baseUrl = import.meta.env.BASE_URL): string {
   const normalizedBase = baseUrl.endsWith('/') ? baseUrl : `${baseUrl}/`
   return `${normalizedBase}${assetPath.replace(/^\//, '')}`
 }
 
 export async function createWebRuntime(): Promise<WebAudioRuntime> {
+  const startMs = performance.now()
   const ctx = new AudioContext({ latencyHint: 'interactive' })
   const wasmPath = resolveRuntimeAssetPath('wasm/moonvst_dsp.wasm')
   const workletPath = resolveRuntimeAssetPath('worklet/processor.js')
 
-  // Load WASM binary
-  const wasmResponse = await fetch(wasmPath)
-  const wasmBytes = await wasmResponse.arrayBuffer()
-  const wasmModule = await WebAssembly.compile(wasmBytes)
-
-  // Register AudioWorklet processor
-  await ctx.audioWorklet.addModule(workletPath)
+  // Compile the DSP module once; the worklet receives the compiled Module.
+  // Worklet registration overlaps with fetch/compile.
+  const [compiled] = await Promise.all([
+    compileDspModule(wasmPath),
+    ctx.audioWorklet.addModule(workletPath),
+  ])
+  const wasmModule = compiled.module
 
   // Also instantiate WASM on main thread for parameter queries
+  const instantiateStart = performance.now()
   const instance = await WebAssembly.instantiate(wasmModule)
   const exports = instance.exports as unknown as WasmExports
   exports.dsp_init()
+  const startupTiming: RuntimeStartupTiming = {
+    fetchMs: compiled.fetchMs,
+    compileMs: compiled.compileMs,
+    instantiateMs: performance.now() - instantiateStart,
+    totalMs: performance.now() - startMs,
+    audioReadyMs: null,
+  }
 
   // Build parameter info
   const count = exports.get_param_count()
@@ -63,8 +116,16 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
     outputChannelCount: [2],
   })
 
-  // Send WASM bytes to worklet
-  workletNode.port.postMessage({ type: 'loadWasm', wasmBytes })
+  // Send the compiled module to the worklet. Without cross-origin isolation the bank is
+  // null and parameters/telemetry fall back to MessagePort traffic.
+  const sharedBank = createSharedParamBank(count)
+  workletNode.port.postMessage({
+    type: 'loadWasm',
+    wasmModule,
+    sharedParams: sharedBank
+      ? { buffer: sharedBank.buffer, paramCount: sharedBank.paramCount, dirtyWords: sharedBank.dirtyWords }
+      : undefined,
+  })
 
   // Connect to destination
   workletNode.connect(ctx.destination)
@@ -92,6 +153,10 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
       currentCpuLoad = Math.max(0, Math.min(1, data.value))
       return
     }
+    if (data?.type === 'ready') {
+      startupTiming.audioReadyMs = performance.now() - startMs
+      return
+    }
     if (data?.type === 'error') {
       console.error('AudioWorklet processor error:', data.message)
     }
@@ -141,10 +206,15 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
     micState = 'inactive'
   }
 
+  const clearLevel = () => {
+    currentLevel = 0
+    if (sharedBank) sharedBank.telemetry[0] = 0
+  }
+
   const resetPlaybackState = () => {
     hasAudio = false
     isPlaying = false
-    currentLevel = 0
+    clearLevel()
     if (!audioElement) return
     audioElement.pause()
     audioElement.currentTime = 0
@@ -208,7 +278,11 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
 
     setParam(index: number, value: number) {
       exports.set_param(index, value)
-      workletNode.port.postMessage({ type: 'setParam', index, value })
+      if (sharedBank) {
+        writeSharedParam(sharedBank, index, value)
+      } else {
+        workletNode.port.postMessage({ type: 'setParam', index, value })
+      }
 
       // Notify listeners
       const cbs = listeners.get(index)
@@ -220,11 +294,15 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
     },
 
     getLevel() {
-      return currentLevel
+      return sharedBank ? sharedBank.telemetry[0] : currentLevel
     },
 
     getCpuLoad() {
-      return currentCpuLoad
+      return sharedBank ? sharedBank.telemetry[1] : currentCpuLoad
+    },
+
+    getStartupTiming() {
+      return startupTiming
     },
 
     getLatencyMs() {
@@ -262,7 +340,7 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
       audioElement.pause()
       audioElement.currentTime = 0
       isPlaying = false
-      currentLevel = 0
+      clearLevel()
     },
 
     async startMic() {
@@ -289,7 +367,7 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
           audioElement.currentTime = 0
         }
         isPlaying = false
-        currentLevel = 0
+        clearLevel()
         ensureAudioGraph()
         stopMicInternal()
         if (mediaSourceNode) {
@@ -309,7 +387,7 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
 
     stopMic() {
       stopMicInternal()
-      currentLevel = 0
+      clearLevel()
     },
 
     hasAudioLoaded() {
@@ -335,7 +413,7 @@ export async function createWebRuntime(): Promise<WebAudioRuntime> {
     },
 
     dispose() {
-      currentLevel = 0
+      clearLevel()
       currentCpuLoad = 0
       stopMicInternal()
       if (audioElement) {
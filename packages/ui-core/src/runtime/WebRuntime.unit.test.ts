@@ -1,5 +1,5 @@
 import { afterEach, beforeEach, describe, expect, test, vi } from 'vitest'
-import { createWebRuntime, resolveRuntimeAssetPath } from './WebRuntime'
+import { createSharedParamBank, createWebRuntime, resolveRuntimeAssetPath, writeSharedParam } from './WebRuntime'
 
 class MockAudioWorkletNode {
   static instances: MockAudioWorkletNode[] = []
@@ -118,6 +118,25 @@ describe('createWebRuntime', () => {
     runtime.dispose()
   })
 
+  test('compiles the module once and transfers it to the worklet', async () => {
+    const runtime = await createWebRuntime()
+    const node = MockAudioWorkletNode.instances[0]
+
+    expect(WebAssembly.compile).toHaveBeenCalledTimes(1)
+    const loadMessage = node.port.postMessage.mock.calls[0][0]
+    expect(loadMessage.type).toBe('loadWasm')
+    expect(loadMessage.wasmModule).toBeDefined()
+    expect(loadMessage.wasmBytes).toBeUndefined()
+
+    const timing = runtime.getStartupTiming?.()
+    expect(timing?.compileMs).toBeGreaterThanOrEqual(0)
+    expect(timing?.audioReadyMs).toBeNull()
+    node.port.onmessage?.({ data: { type: 'ready' } })
+    expect(runtime.getStartupTiming?.()?.audioReadyMs).toBeGreaterThanOrEqual(0)
+
+    runtime.dispose()
+  })
+
   test('throws when wasm fetch fails', async () => {
     vi.stubGlobal('fetch', vi.fn(async () => {
       throw new Error('network down')
@@ -147,6 +166,75 @@ describe('createWebRuntime', () => {
     expect(runtime.getInputMode()).toBe('none')
     expect(runtime.getMicState()).toBe('inactive')
   })
+
+  test('falls back to MessagePort params when not cross-origin isolated', async () => {
+    vi.stubGlobal('crossOriginIsolated', false)
+    const runtime = await createWebRuntime()
+    const node = MockAudioWorkletNode.instances[0]
+
+    const loadMessage = node.port.postMessage.mock.calls[0][0]
+    expect(loadMessage.type).toBe('loadWasm')
+    expect(loadMessage.sharedParams).toBeUndefined()
+
+    runtime.setParam(0, 0.25)
+    expect(node.port.postMessage).toHaveBeenCalledWith({ type: 'setParam', index: 0, value: 0.25 })
+
+    runtime.dispose()
+  })
+
+  test('uses the shared param bank when cross-origin isolated', async () => {
+    vi.stubGlobal('crossOriginIsolated', true)
+    const runtime = await createWebRuntime()
+    const node = MockAudioWorkletNode.instances[0]
+
+    const loadMessage = node.port.postMessage.mock.calls[0][0]
+    expect(loadMessage.sharedParams.buffer).toBeInstanceOf(SharedArrayBuffer)
+    expect(loadMessage.sharedParams.paramCount).toBe(1)
+
+    for (let i = 0; i < 200; i++) {
+      runtime.setParam(0, i / 200)
+    }
+    expect(node.port.postMessage).toHaveBeenCalledTimes(1)
+
+    const dirty = new Int32Array(loadMessage.sharedParams.buffer, 0, loadMessage.sharedParams.dirtyWords)
+    const values = new Float32Array(loadMessage.sharedParams.buffer, loadMessage.sharedParams.dirtyWords * 4, 1)
+    expect(dirty[0]).toBe(1)
+    expect(values[0]).toBeCloseTo(199 / 200, 5)
+
+    const telemetry = new Float32Array(loadMessage.sharedParams.buffer, (loadMessage.sharedParams.dirtyWords + 1) * 4, 2)
+    telemetry[0] = 0.5
+    telemetry[1] = 0.125
+    expect(runtime.getLevel()).toBeCloseTo(0.5, 5)
+    expect(runtime.getCpuLoad?.()).toBeCloseTo(0.125, 5)
+
+    runtime.dispose()
+  })
+})
+
+describe('createSharedParamBank', () => {
+  afterEach(() => {
+    vi.unstubAllGlobals()
+  })
+
+  test('returns null without cross-origin isolation', () => {
+    vi.stubGlobal('crossOriginIsolated', false)
+    expect(createSharedParamBank(4)).toBeNull()
+  })
+
+  test('marks one dirty bit per written parameter', () => {
+    vi.stubGlobal('crossOriginIsolated', true)
+    const bank = createSharedParamBank(70)!
+    expect(bank.dirtyWords).toBe(3)
+
+    writeSharedParam(bank, 0, 1)
+    writeSharedParam(bank, 33, 2)
+    writeSharedParam(bank, 69, 3)
+    writeSharedParam(bank, 70, 4)
+
+    expect(Array.from(bank.dirty)).toEqual([1, 2, 1 << 5])
+    expect(bank.values[33]).toBe(2)
+    expect(bank.values[69]).toBe(3)
+  })
 })
 
 describe('resolveRuntimeAssetPath', () => {
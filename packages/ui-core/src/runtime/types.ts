@@ -6,6 +6,33 @@ export interface ParamInfo {
   defaultValue: number
 }
 
+export interface RuntimeStartupTiming {
+  fetchMs: number
+  compileMs: number
+  instantiateMs: number
+  totalMs: number
+  /** Time until the audio thread reported ready; null while still loading. */
+  audioReadyMs: number | null
+}
+
+export interface RuntimeMemoryUsage {
+  /** Current size of the DSP's linear memory (WASM memory or native arena). */
+  linearMemoryBytes: number
+  /** Linear memory plus the runtime stacks and heap reserved for the instance. */
+  residentBytes: number
+}
+
+export interface RuntimeDspHealth {
+  /** Calls into the DSP that trapped. */
+  traps: number
+  /** Blocks the watchdog terminated for running past their time budget. */
+  overruns: number
+  /** Times the DSP instance was rebuilt after a fault. */
+  recoveries: number
+  /** True while the plugin passes dry audio waiting for a rebuild. */
+  faulted: boolean
+}
+
 export interface AudioRuntime {
   readonly type: 'juce' | 'web'
   getParams(): ParamInfo[]
@@ -14,6 +41,14 @@ export interface AudioRuntime {
   getLevel(): number
   getCpuLoad?(): number | null
   getLatencyMs?(): number | null
+  getStartupTiming?(): RuntimeStartupTiming | null
+  getMemoryUsage?(): RuntimeMemoryUsage | null
+  getDspHealth?(): RuntimeDspHealth | null
+  /**
+   * Newest output spectrum: 64 log-spaced bands from 20 Hz to 20 kHz, each
+   * 0-255 over -90..0 dBFS. Null until the first frame arrives.
+   */
+  getSpectrum?(): Uint8Array | null
   onParamChange(index: number, cb: (v: number) => void): () => void
   invokeNative?(name: string, ...args: unknown[]): Promise<unknown>
   dispose(): void
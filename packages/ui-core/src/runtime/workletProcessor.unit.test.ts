@@ -0,0 +1,103 @@
+import { afterEach, describe, expect, test, vi } from 'vitest'
+import processorSource from '../../public/worklet/processor.js?raw'
+import { createSharedParamBank, writeSharedParam, type SharedParamBank } from './WebRuntime'
+
+interface ProcessorUnderTest {
+  wasmExports: { set_param(index: number, value: number): void }
+  attachSharedParams(bank: { buffer: SharedArrayBuffer; paramCount: number; dirtyWords: number }): void
+  drainSharedParams(): void
+}
+
+// Evaluates the worklet script with the AudioWorkletGlobalScope names it uses
+// and returns a fresh instance of the processor it registers.
+function createProcessor(): ProcessorUnderTest {
+  class AudioWorkletProcessorStub {
+    port = { postMessage: vi.fn(), onmessage: null as ((e: MessageEvent) => void) | null }
+  }
+  const registered: { processor?: new () => ProcessorUnderTest } = {}
+  const registerProcessor = (_name: string, processor: new () => ProcessorUnderTest) => {
+    registered.processor = processor
+  }
+  new Function('AudioWorkletProcessor', 'registerProcessor', 'sampleRate', processorSource)(
+    AudioWorkletProcessorStub,
+    registerProcessor,
+    48000,
+  )
+  return new registered.processor!()
+}
+
+describe('worklet shared parameter drain', () => {
+  afterEach(() => {
+    vi.restoreAllMocks()
+    vi.unstubAllGlobals()
+  })
+
+  // A graph edit writes its parameters, then bumps the revision in the last
+  // slot; the DSP applies the graph when it sees the revision.
+  const paramCount = 71
+  const graphParam = 3
+  const revisionParam = paramCount - 1
+
+  test('never applies a revision before the writes it publishes', () => {
+    vi.stubGlobal('crossOriginIsolated', true)
+    const originalExchange = Atomics.exchange
+    const dirtyWords = Math.ceil(paramCount / 32)
+
+    // Land the writer's edit after each of the drain's word swaps in turn.
+    for (let interleaveAfter = 1; interleaveAfter <= dirtyWords; interleaveAfter++) {
+      const bank: SharedParamBank = createSharedParamBank(paramCount)!
+      const processor = createProcessor()
+      const applied = new Map<number, number>()
+      let revisionAppliedEarly = false
+      processor.wasmExports = {
+        set_param: (index, value) => {
+          if (index === revisionParam && value === 2 && applied.get(graphParam) !== 0.75) {
+            revisionAppliedEarly = true
+          }
+          applied.set(index, value)
+        },
+      }
+      processor.attachSharedParams({ buffer: bank.buffer, paramCount, dirtyWords: bank.dirtyWords })
+
+      // Unrelated changes keep every word dirty, so the drain swaps each one.
+      writeSharedParam(bank, 0, 0.1)
+      writeSharedParam(bank, 40, 0.2)
+      writeSharedParam(bank, 65, 0.3)
+
+      let swaps = 0
+      vi.spyOn(Atomics, 'exchange').mockImplementation((array, index, value) => {
+        const previous = originalExchange(array as Int32Array, index, value as number)
+        if (++swaps === interleaveAfter) {
+          writeSharedParam(bank, graphParam, 0.75)
+          writeSharedParam(bank, revisionParam, 2)
+        }
+        return previous
+      })
+      processor.drainSharedParams()
+      vi.mocked(Atomics.exchange).mockRestore()
+      processor.drainSharedParams()
+
+      expect(revisionAppliedEarly).toBe(false)
+      expect(applied.get(graphParam)).toBe(0.75)
+      expect(applied.get(revisionParam)).toBe(2)
+      expect(applied.get(40)).toBeCloseTo(0.2)
+      expect(Array.from(bank.dirty)).toEqual(new Array(dirtyWords).fill(0))
+    }
+  })
+
+  test('applies a drained snapshot in ascending parameter order', () => {
+    vi.stubGlobal('crossOriginIsolated', true)
+    const bank = createSharedParamBank(paramCount)!
+    const processor = createProcessor()
+    const order: number[] = []
+    processor.wasmExports = { set_param: (index) => order.push(index) }
+    processor.attachSharedParams({ buffer: bank.buffer, paramCount, dirtyWords: bank.dirtyWords })
+
+    writeSharedParam(bank, revisionParam, 1)
+    writeSharedParam(bank, 40, 0.5)
+    writeSharedParam(bank, graphParam, 0.5)
+    processor.drainSharedParams()
+
+    expect(order).toEqual([graphParam, 40, revisionParam])
+  })
+})
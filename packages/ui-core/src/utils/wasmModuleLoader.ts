@@ -0,0 +1,37 @@
+export interface CompiledDspModule {
+  module: WebAssembly.Module
+  fetchMs: number
+  compileMs: number
+}
+
+const now = () => (typeof performance !== 'undefined' ? performance.now() : Date.now())
+
+function isStreamable(response: Response): boolean {
+  const contentType = response.headers?.get('Content-Type') ?? ''
+  return contentType.split(';')[0].trim().toLowerCase() === 'application/wasm'
+}
+
+/**
+ * Fetch and compile the DSP module once per page load.
+ *
+ * A response served as application/wasm is compiled while it downloads via
+ * compileStreaming, which also lets the browser reuse its own code cache for
+ * the URL on the next load. Anything else is buffered and compiled in one go.
+ * The Module is not persisted: engines no longer structured-clone
+ * WebAssembly.Module into IndexedDB.
+ */
+export async function compileDspModule(url: string): Promise<CompiledDspModule> {
+  const startMs = now()
+  const response = await fetch(url)
+
+  if (typeof WebAssembly.compileStreaming === 'function' && isStreamable(response)) {
+    const module = await WebAssembly.compileStreaming(response)
+    return { module, fetchMs: 0, compileMs: now() - startMs }
+  }
+
+  const bytes = await response.arrayBuffer()
+  const fetchMs = now() - startMs
+  const compileStart = now()
+  const module = await WebAssembly.compile(bytes)
+  return { module, fetchMs, compileMs: now() - compileStart }
+}
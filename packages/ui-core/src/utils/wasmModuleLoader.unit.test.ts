@@ -0,0 +1,49 @@
+import { afterEach, describe, expect, test, vi } from 'vitest'
+import { compileDspModule } from './wasmModuleLoader'
+
+describe('wasmModuleLoader', () => {
+  const originalCompile = WebAssembly.compile
+  const originalCompileStreaming = WebAssembly.compileStreaming
+
+  afterEach(() => {
+    vi.unstubAllGlobals()
+    WebAssembly.compile = originalCompile
+    WebAssembly.compileStreaming = originalCompileStreaming
+  })
+
+  test('streams a response served as application/wasm', async () => {
+    const module = {} as WebAssembly.Module
+    const response = {
+      headers: new Headers({ 'Content-Type': 'application/wasm' }),
+      arrayBuffer: vi.fn(async () => new Uint8Array([1, 2, 3]).buffer),
+    }
+    WebAssembly.compile = vi.fn(async () => module)
+    WebAssembly.compileStreaming = vi.fn(async () => module)
+    vi.stubGlobal('fetch', vi.fn(async () => response))
+
+    const result = await compileDspModule('/wasm/moonvst_dsp.wasm')
+
+    expect(result.module).toBe(module)
+    expect(WebAssembly.compileStreaming).toHaveBeenCalledWith(response)
+    expect(WebAssembly.compile).not.toHaveBeenCalled()
+    expect(response.arrayBuffer).not.toHaveBeenCalled()
+    expect(fetch).toHaveBeenCalledTimes(1)
+  })
+
+  test('compiles buffered bytes once when the server sends another type', async () => {
+    const module = {} as WebAssembly.Module
+    WebAssembly.compile = vi.fn(async () => module)
+    WebAssembly.compileStreaming = vi.fn(async () => module)
+    vi.stubGlobal('fetch', vi.fn(async () => ({
+      headers: new Headers({ 'Content-Type': 'application/octet-stream' }),
+      arrayBuffer: async () => new Uint8Array([1, 2, 3]).buffer,
+    })))
+
+    const result = await compileDspModule('/wasm/moonvst_dsp.wasm')
+
+    expect(result.module).toBe(module)
+    expect(WebAssembly.compileStreaming).not.toHaveBeenCalled()
+    expect(WebAssembly.compile).toHaveBeenCalledTimes(1)
+    expect(fetch).toHaveBeenCalledTimes(1)
+  })
+})
@@ -14,7 +14,7 @@ test.beforeEach(async ({ page }) => {
 
     const getNativeFunction = (name: string) => {
       if (name === 'getParamCount') {
-        return async () => 315
+        return async () => 1931
       }
       if (name === 'getParamInfo') {
         return async (index: number) => ({
@@ -8,6 +8,14 @@ const product = process.env.VITE_PRODUCT === 'showcase' ? 'showcase' : 'template
 const base = process.env.VITE_BASE_PATH ?? '/'
 const dspWasmPath = path.resolve(__dirname, 'public', 'wasm', 'moonvst_dsp.wasm')
 
+// Cross-origin isolation unlocks SharedArrayBuffer, which the web runtime
+// uses for its parameter bank. Hosts that cannot send these headers still
+// work through the MessagePort fallback.
+const crossOriginIsolationHeaders = {
+  'Cross-Origin-Opener-Policy': 'same-origin',
+  'Cross-Origin-Embedder-Policy': 'require-corp',
+}
+
 function normalizePath(filePath: string): string {
   return path.resolve(filePath).replace(/\\/g, '/').toLowerCase()
 }
@@ -41,6 +49,12 @@ export default defineConfig({
     dspWasmReloadPlugin(),
     ...(isJuceBuild ? [viteSingleFile()] : []),
   ],
+  server: {
+    headers: crossOriginIsolationHeaders,
+  },
+  preview: {
+    headers: crossOriginIsolationHeaders,
+  },
   build: {
     outDir: isJuceBuild ? 'dist' : 'dist-web',
     ...(isJuceBuild && {
@@ -0,0 +1,15 @@
+# Build-time helper: gzip a single UI asset.
+# Usage: cmake -DINPUT=<file> -DOUTPUT=<file.gz> -P GzipResource.cmake
+if(NOT DEFINED INPUT OR NOT DEFINED OUTPUT)
+    message(FATAL_ERROR "GzipResource.cmake requires INPUT and OUTPUT")
+endif()
+
+get_filename_component(output_dir "${OUTPUT}" DIRECTORY)
+file(MAKE_DIRECTORY "${output_dir}")
+file(ARCHIVE_CREATE
+    OUTPUT "${OUTPUT}"
+    PATHS "${INPUT}"
+    FORMAT raw
+    COMPRESSION GZip
+    COMPRESSION_LEVEL 9
+)
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Memory held by a running DSP instance, reported to the editor.
+struct DSPMemoryUsage
+{
+    size_t linearMemoryBytes = 0; // DSP linear memory (WASM memory or native arena)
+    size_t residentBytes = 0;     // linear memory plus runtime stacks and heap
+};
+
+// Fault counters for backends that can trap or overrun their time budget.
+struct DSPHealth
+{
+    uint32_t traps = 0;      // calls into the DSP that trapped
+    uint32_t overruns = 0;   // blocks terminated for exceeding the watchdog budget
+    uint32_t recoveries = 0; // successful re-instantiations after a fault
+    bool faulted = false;    // output is currently the dry input
+};
+
+// Common interface for the DSP engines the plugin can host.
+// WasmDSP runs the MoonBit core inside WAMR; NativeDSP links the
+// C-backend build of the same sources directly into the plugin.
+class DSPBackend
+{
+public:
+    virtual ~DSPBackend() = default;
+
+    virtual bool initialize() = 0;
+    virtual void shutdown() = 0;
+    virtual void prepare (double sampleRate, int samplesPerBlock) = 0;
+    // Host bus layout, called before prepare(). With fewer inputs than outputs
+    // (mono in, stereo out) only the input channels are handed to the DSP,
+    // which fans them out. Backends that ignore it treat every buffer channel
+    // as both input and output.
+    virtual void setChannelLayout (int /*numInputChannels*/, int /*numOutputChannels*/) {}
+    virtual void processBlock (juce::AudioBuffer<float>& buffer) = 0;
+
+    // Generic parameter API
+    virtual int getParamCount() = 0;
+    virtual std::string getParamName (int index) = 0;
+    virtual float getParamDefault (int index) = 0;
+    virtual float getParamMin (int index) = 0;
+    virtual float getParamMax (int index) = 0;
+    virtual void setParam (int index, float value) = 0;
+    virtual float getParam (int index) = 0;
+
+    virtual DSPMemoryUsage getMemoryUsage() const { return {}; }
+    virtual DSPHealth getHealth() const { return {}; }
+
+    virtual const char* getBackendName() const = 0;
+};
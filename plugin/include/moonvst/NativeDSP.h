@@ -0,0 +1,51 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <string>
+#include <atomic>
+#include "memory_layout_gen.h"
+#include "DSPBackend.h"
+
+// DSP core compiled through MoonBit's C backend and linked into the plugin.
+// Module globals are process-wide in a native build, so only one NativeDSP
+// can be live at a time; initialize() fails for any further instance and
+// the caller is expected to fall back to WasmDSP.
+class NativeDSP : public DSPBackend
+{
+public:
+    NativeDSP();
+    ~NativeDSP() override;
+
+    // True when the plugin was configured with MOONVST_NATIVE_DSP=ON.
+    static bool isAvailable();
+
+    bool initialize() override;
+    void shutdown() override;
+    void prepare (double sampleRate, int samplesPerBlock) override;
+    void setChannelLayout (int numInputChannels, int numOutputChannels) override;
+    void processBlock (juce::AudioBuffer<float>& buffer) override;
+
+    // Generic parameter API
+    int getParamCount() override;
+    std::string getParamName (int index) override;
+    float getParamDefault (int index) override;
+    float getParamMin (int index) override;
+    float getParamMax (int index) override;
+    void setParam (int index, float value) override;
+    float getParam (int index) override;
+
+    DSPMemoryUsage getMemoryUsage() const override;
+
+    const char* getBackendName() const override { return "native"; }
+
+private:
+    static constexpr int MAX_CHANNELS = moonvst::memory_layout::MAX_CHANNELS;
+    static constexpr int MAX_BUFFER_SAMPLES = moonvst::memory_layout::MAX_BUFFER_SAMPLES;
+
+    std::atomic<bool> initialized_ { false };
+    uint8_t* arena_ = nullptr;
+    int hostInputChannels_ = 0; // 0 = follow the buffer
+    int hostOutputChannels_ = 0;
+    int sentInputChannels_ = 0;
+    int sentOutputChannels_ = 0;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+// Timeline tracer for diagnosing dropouts. Configure with
+// -DMOONVST_ENABLE_TRACE=ON to compile it in; otherwise every macro below
+// expands to nothing and no tracer code is linked into the hot paths.
+//
+// Each thread writes into its own preallocated single-producer ring, leased
+// on the thread's first event and returned when the thread exits, so
+// recording never locks or allocates. While a capture is running a
+// background thread drains the rings; stopping the capture writes Chrome
+// trace JSON that loads in chrome://tracing and ui.perfetto.dev.
+#if MOONVST_ENABLE_TRACE
+
+namespace moonvst::trace
+{
+// Threads that can record at once. Events from threads beyond this are
+// counted as "untraced" on the dropped_events counter.
+constexpr int kMaxTracedThreads = 16;
+
+// Event names must be string literals: only the pointer is recorded.
+void begin (const char* name) noexcept;
+void end (const char* name) noexcept;
+void instant (const char* name) noexcept;
+
+bool isCapturing() noexcept;
+// Returns false if a capture is already running.
+bool startCapture();
+// Drains the remaining events and writes the capture to destination. Returns
+// false if no capture was running or the file could not be written.
+bool stopCapture (const juce::File& destination);
+
+class ScopedEvent
+{
+public:
+    explicit ScopedEvent (const char* name) noexcept : name_ (name) { begin (name_); }
+    ~ScopedEvent() { end (name_); }
+
+    ScopedEvent (const ScopedEvent&) = delete;
+    ScopedEvent& operator= (const ScopedEvent&) = delete;
+
+private:
+    const char* name_;
+};
+}
+
+ #define MOONVST_TRACE_SCOPE(name) const moonvst::trace::ScopedEvent JUCE_JOIN_MACRO (moonvstTraceScope_, __LINE__) (name)
+ #define MOONVST_TRACE_INSTANT(name) moonvst::trace::instant (name)
+
+#else
+
+ #define MOONVST_TRACE_SCOPE(name)
+ #define MOONVST_TRACE_INSTANT(name)
+
+#endif
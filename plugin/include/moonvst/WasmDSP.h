@@ -3,28 +3,59 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <string>
 #include <atomic>
+#include <vector>
 #include "wasm_export.h"
 #include "memory_layout_gen.h"
+#include "DSPBackend.h"
 
-class WasmDSP
+// WAMR execution modes, in fallback order. The plugin embeds both the AOT
+// image and the .wasm bytecode; initialize() starts at the preferred mode and
+// walks down the list until one loads and instantiates.
+enum class WasmExecutionMode
+{
+    aot,
+    llvmJit,
+    fastJit,
+    interpreter
+};
+
+class WasmDSP : public DSPBackend
 {
 public:
-    WasmDSP();
-    ~WasmDSP();
+    explicit WasmDSP (WasmExecutionMode preferredMode = getDefaultExecutionMode());
+    ~WasmDSP() override;
+
+    // MOONVST_WASM_MODE=aot|jit|fast-jit|interp picks the starting mode; AOT otherwise.
+    static WasmExecutionMode getDefaultExecutionMode();
+    static bool isExecutionModeSupported (WasmExecutionMode mode);
+    static const char* getExecutionModeName (WasmExecutionMode mode);
 
-    bool initialize();
-    void shutdown();
-    void prepare (double sampleRate, int samplesPerBlock);
-    void processBlock (juce::AudioBuffer<float>& buffer);
+    // Mode the current instance actually runs in; only meaningful after initialize().
+    WasmExecutionMode getExecutionMode() const { return activeMode_; }
+
+    bool initialize() override;
+    void shutdown() override;
+    void prepare (double sampleRate, int samplesPerBlock) override;
+    void setChannelLayout (int numInputChannels, int numOutputChannels) override;
+    void processBlock (juce::AudioBuffer<float>& buffer) override;
 
     // Generic parameter API
-    int getParamCount();
-    std::string getParamName (int index);
-    float getParamDefault (int index);
-    float getParamMin (int index);
-    float getParamMax (int index);
-    void setParam (int index, float value);
-    float getParam (int index);
+    int getParamCount() override;
+    std::string getParamName (int index) override;
+    float getParamDefault (int index) override;
+    float getParamMin (int index) override;
+    float getParamMax (int index) override;
+    void setParam (int index, float value) override;
+    float getParam (int index) override;
+
+    DSPMemoryUsage getMemoryUsage() const override;
+    DSPHealth getHealth() const override;
+
+    const char* getBackendName() const override;
+
+    // Test hook: makes the next call into the module fail as a trap would, so
+    // tests can drive the fault and rebuild path without a broken module.
+    void forceTrapForTesting();
 
 private:
     // WAMR runtime handles
@@ -35,6 +66,7 @@ private:
     // Generic function pointers (looked up by name)
     wasm_function_inst_t fn_init_ = nullptr;
     wasm_function_inst_t fn_dsp_prepare_ = nullptr;
+    wasm_function_inst_t fn_set_channel_layout_ = nullptr;
     wasm_function_inst_t fn_process_block_ = nullptr;
     wasm_function_inst_t fn_get_param_count_ = nullptr;
     wasm_function_inst_t fn_get_param_name_ = nullptr;
@@ -45,14 +77,66 @@ private:
     wasm_function_inst_t fn_set_param_ = nullptr;
     wasm_function_inst_t fn_get_param_ = nullptr;
 
-    static constexpr int INPUT_LEFT_OFFSET = moonvst::memory_layout::INPUT_LEFT_OFFSET;
-    static constexpr int INPUT_RIGHT_OFFSET = moonvst::memory_layout::INPUT_RIGHT_OFFSET;
-    static constexpr int OUTPUT_LEFT_OFFSET = moonvst::memory_layout::OUTPUT_LEFT_OFFSET;
-    static constexpr int OUTPUT_RIGHT_OFFSET = moonvst::memory_layout::OUTPUT_RIGHT_OFFSET;
+    static constexpr int MAX_CHANNELS = moonvst::memory_layout::MAX_CHANNELS;
     static constexpr int MAX_BUFFER_SAMPLES = moonvst::memory_layout::MAX_BUFFER_SAMPLES;
 
     std::atomic<bool> initialized_ { false };
     int cachedParamCount_ = 0;
+    // Host layout from setChannelLayout(); 0 = follow the buffer.
+    int hostInputChannels_ = 0;
+    int hostOutputChannels_ = 0;
+    // Last layout passed to dsp_set_channel_layout; 0 = not sent yet.
+    int sentInputChannels_ = 0;
+    int sentOutputChannels_ = 0;
+
+    WasmExecutionMode preferredMode_;
+    WasmExecutionMode activeMode_;
+    // Private copy of the bytecode: WAMR may patch a .wasm buffer in place and
+    // references it until the module is unloaded.
+    std::vector<uint8_t> bytecode_;
+
+    // Fault handling. A trap or a watchdog termination marks the instance
+    // faulted; the audio thread then leaves the buffer dry and never touches
+    // the instance again until the watchdog thread has rebuilt it from the
+    // loaded module and flipped it back to running.
+    enum InstanceState : int { instanceRunning, instanceFaulted };
+
+    // Written by the audio thread on every block. They get a cache line to
+    // themselves so neither this instance's watchdog-side fields nor a
+    // neighbouring instance on another core share it.
+    static constexpr size_t kCacheLineBytes = 64;
+    alignas (kCacheLineBytes) std::atomic<int64_t> blockStartNs_ { 0 };  // 0 while no call is in flight
+    std::atomic<uint32_t> completedBlocks_ { 0 };
+    std::atomic<size_t> linearMemoryBytes_ { 0 };
+
+    alignas (kCacheLineBytes) std::atomic<int> state_ { instanceRunning };
+    std::atomic<int64_t> budgetNs_ { 0 };
+    std::atomic<bool> terminateRequested_ { false };
+    std::atomic<uint32_t> traps_ { 0 };
+    std::atomic<uint32_t> overruns_ { 0 };
+    std::atomic<uint32_t> recoveries_ { 0 };
+    std::atomic<double> preparedSampleRate_ { 0.0 };
+    std::atomic<int> preparedBlockSize_ { 0 };
+
+    // One watchdog thread polls every instance in the process (WasmDSP.cpp).
+    class Watchdog;
+    bool watched_ = false;
+    // Recovery backoff; only the watchdog thread touches these.
+    int consecutiveFaults_ = 0;
+    int64_t retryAtNs_ = 0;
+    uint32_t blocksAtRecovery_ = 0;
+
+    void startWatchdog();
+    void stopWatchdog();
+    void pollWatchdog (int64_t now);
+    void handleCallFailure();
+    bool reinstantiate();
+    bool callPrepare();
 
+    bool loadInstance (WasmExecutionMode mode);
+    bool instantiateModule (WasmExecutionMode mode);
+    void releaseModuleInstance();
+    void releaseInstance();
     bool lookupFunctions();
+    void refreshMemoryUsage();
 };
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "wasm_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Linux perf symbol map for AOT-compiled DSP code. Configure with
+// -DMOONVST_WASM_PERF_MAP=ON against a WAMR built with
+// -DWAMR_BUILD_LINUX_PERF=1, then run the host with MOONVST_PERF_MAP=1.
+//
+// WAMR appends the code range of every AOT function it loads to
+// /tmp/perf-<pid>.map as "aot_func#N". Right after each load a second entry
+// for each of those ranges is appended, named after the function in the
+// embedded bytecode (its name section, or its export name when the section
+// was stripped), so perf report / perf top can attribute samples to e.g.
+// process_reverb_sample. The map is never truncated or rewritten: other JITs
+// in the host may be appending to it at the same time. The aot_func#N lines
+// therefore stay, and a symboliser may still pick one of them for a range.
+#if MOONVST_WASM_PERF_MAP
+
+namespace moonvst::perf_map
+{
+// True when MOONVST_PERF_MAP is set to anything other than "0". Read once.
+bool isRequested();
+
+// Loads an AOT image named moduleName and appends named copies of the map
+// entries the load added, using the function names in bytecode (the
+// module's .wasm). Loads are serialised so each one only names its own
+// entries.
+wasm_module_t loadAotModule (uint8_t* image, uint32_t imageSize,
+                             const uint8_t* bytecode, size_t bytecodeSize,
+                             const char* moduleName, char* errorBuf, uint32_t errorBufSize);
+
+// Names of the module's defined functions (imports excluded), indexed the
+// way WAMR numbers AOT functions. Unnamed functions are empty strings; a
+// malformed module yields an empty vector.
+std::vector<std::string> definedFunctionNames (const uint8_t* bytecode, size_t size);
+}
+
+#endif
@@ -3,12 +3,17 @@
 
 namespace moonvst::memory_layout {
 static constexpr int BYTES_PER_SAMPLE = 4;
-static constexpr int INPUT_LEFT_OFFSET = 0x10000;
-static constexpr int INPUT_RIGHT_OFFSET = 0x20000;
-static constexpr int OUTPUT_LEFT_OFFSET = 0x30000;
-static constexpr int OUTPUT_RIGHT_OFFSET = 0x40000;
-static constexpr int STRING_BUF_OFFSET = 0x50000;
-static constexpr int REVERB_MEM_BASE_PTR = 0x60000;
-static constexpr int CHORUS_MEM_BASE_PTR = 0x78000;
+static constexpr int MAX_CHANNELS = 12;
+static constexpr int CHANNEL_STRIDE_BYTES = 0x10000;
+static constexpr int INPUT_BASE_OFFSET = 0x10000;
+static constexpr int OUTPUT_BASE_OFFSET = 0xD0000;
+static constexpr int STRING_BUF_OFFSET = 0x190000;
+static constexpr int STRING_BUF_BYTES = 256;
+static constexpr int REVERB_MEM_BASE_PTR = 0x1A0140;
+static constexpr int CHORUS_MEM_BASE_PTR = 0x190100;
 static constexpr int MAX_BUFFER_SAMPLES = 16384;
+static constexpr int HEAP_START_ADDRESS = 0x240000;
+
+constexpr int inputChannelOffset (int channel) { return INPUT_BASE_OFFSET + channel * CHANNEL_STRIDE_BYTES; }
+constexpr int outputChannelOffset (int channel) { return OUTPUT_BASE_OFFSET + channel * CHANNEL_STRIDE_BYTES; }
 }
@@ -0,0 +1,227 @@
+#include "moonvst/NativeDSP.h"
+#include <cstring>
+#include <mutex>
+
+#if ! MOONVST_HAS_NATIVE_DSP
+
+NativeDSP::NativeDSP() = default;
+NativeDSP::~NativeDSP() = default;
+
+bool NativeDSP::isAvailable() { return false; }
+bool NativeDSP::initialize() { return false; }
+void NativeDSP::shutdown() {}
+void NativeDSP::prepare (double, int) {}
+void NativeDSP::setChannelLayout (int, int) {}
+void NativeDSP::processBlock (juce::AudioBuffer<float>&) {}
+int NativeDSP::getParamCount() { return 0; }
+std::string NativeDSP::getParamName (int) { return ""; }
+float NativeDSP::getParamDefault (int) { return 0.0f; }
+float NativeDSP::getParamMin (int) { return 0.0f; }
+float NativeDSP::getParamMax (int) { return 1.0f; }
+void NativeDSP::setParam (int, float) {}
+DSPMemoryUsage NativeDSP::getMemoryUsage() const { return {}; }
+float NativeDSP::getParam (int) { return 0.0f; }
+
+#else
+
+// Symbols from the MoonBit C-backend output (see the "native" link section of
+// packages/dsp-core/src/moon.pkg.json) and the utils native memory stub.
+extern "C"
+{
+void moonbit_runtime_init (int argc, char** argv);
+void moonbit_init (void);
+
+void moonvst_dsp_init (void);
+void moonvst_dsp_prepare (float sampleRate, int32_t maxBlockSize);
+void moonvst_dsp_set_channel_layout (int32_t inputChannels, int32_t outputChannels);
+void moonvst_process_block (int32_t numSamples);
+int32_t moonvst_get_param_count (void);
+int32_t moonvst_get_param_name (int32_t index);
+int32_t moonvst_get_param_name_len (int32_t index);
+float moonvst_get_param_default (int32_t index);
+float moonvst_get_param_min (int32_t index);
+float moonvst_get_param_max (int32_t index);
+void moonvst_set_param (int32_t index, float value);
+float moonvst_get_param (int32_t index);
+
+uint8_t* moonvst_native_arena_base (void);
+int32_t moonvst_native_arena_size (void);
+}
+
+namespace
+{
+std::atomic<bool> nativeCoreClaimed { false };
+
+void ensureMoonbitRuntimeInitialized()
+{
+    static std::once_flag once;
+    std::call_once (once, []
+    {
+        moonbit_runtime_init (0, nullptr);
+        moonbit_init();
+    });
+}
+}
+
+NativeDSP::NativeDSP() = default;
+
+NativeDSP::~NativeDSP()
+{
+    shutdown();
+}
+
+bool NativeDSP::isAvailable() { return true; }
+
+bool NativeDSP::initialize()
+{
+    if (initialized_.load())
+        return true;
+
+    bool expected = false;
+    if (! nativeCoreClaimed.compare_exchange_strong (expected, true))
+        return false;
+
+    ensureMoonbitRuntimeInitialized();
+
+    arena_ = moonvst_native_arena_base();
+    // The arena must hold every contract region, which all end below the heap start.
+    if (arena_ == nullptr
+        || moonvst_native_arena_size() < moonvst::memory_layout::HEAP_START_ADDRESS)
+    {
+        arena_ = nullptr;
+        nativeCoreClaimed.store (false);
+        return false;
+    }
+
+    moonvst_dsp_init();
+    sentInputChannels_ = 0;
+    sentOutputChannels_ = 0;
+
+    initialized_.store (true);
+    return true;
+}
+
+void NativeDSP::shutdown()
+{
+    if (! initialized_.exchange (false))
+        return;
+
+    arena_ = nullptr;
+    nativeCoreClaimed.store (false);
+}
+
+void NativeDSP::prepare (double sampleRate, int samplesPerBlock)
+{
+    if (! initialized_.load())
+        return;
+
+    moonvst_dsp_prepare ((float) sampleRate, (int32_t) juce::jmin (samplesPerBlock, MAX_BUFFER_SAMPLES));
+}
+
+void NativeDSP::setChannelLayout (int numInputChannels, int numOutputChannels)
+{
+    hostInputChannels_ = juce::jmax (0, numInputChannels);
+    hostOutputChannels_ = juce::jmax (0, numOutputChannels);
+}
+
+void NativeDSP::processBlock (juce::AudioBuffer<float>& buffer)
+{
+    if (! initialized_.load())
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+    // Channels past the layout's maximum are left untouched (dry).
+    const int bufferChannels = hostOutputChannels_ > 0 ? juce::jmin (hostOutputChannels_, buffer.getNumChannels())
+                                                       : buffer.getNumChannels();
+    const int numChannels = juce::jmin (bufferChannels, MAX_CHANNELS);
+    const int numInputs = hostInputChannels_ > 0 ? juce::jlimit (1, numChannels, hostInputChannels_)
+                                                 : numChannels;
+
+    if (numSamples > MAX_BUFFER_SAMPLES || numChannels <= 0)
+        return;
+
+    if (numInputs != sentInputChannels_ || numChannels != sentOutputChannels_)
+    {
+        moonvst_dsp_set_channel_layout (numInputs, numChannels);
+        sentInputChannels_ = numInputs;
+        sentOutputChannels_ = numChannels;
+    }
+
+    // The core still addresses its I/O regions by offset, so the host block is
+    // staged through the arena exactly as WasmDSP stages it through linear memory.
+    for (int ch = 0; ch < numInputs; ++ch)
+        std::memcpy (arena_ + moonvst::memory_layout::inputChannelOffset (ch),
+                     buffer.getReadPointer (ch),
+                     (size_t) numSamples * sizeof (float));
+
+    moonvst_process_block (numSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        std::memcpy (buffer.getWritePointer (ch),
+                     arena_ + moonvst::memory_layout::outputChannelOffset (ch),
+                     (size_t) numSamples * sizeof (float));
+}
+
+int NativeDSP::getParamCount()
+{
+    if (! initialized_.load())
+        return 0;
+
+    return juce::jmax (0, (int) moonvst_get_param_count());
+}
+
+std::string NativeDSP::getParamName (int index)
+{
+    if (! initialized_.load())
+        return "";
+
+    const int nameLen = moonvst_get_param_name_len (index);
+    const int namePtr = moonvst_get_param_name (index);
+
+    if (namePtr == 0 || nameLen <= 0 || nameLen > moonvst::memory_layout::STRING_BUF_BYTES)
+        return "";
+
+    if (namePtr + nameLen > moonvst_native_arena_size())
+        return "";
+
+    return std::string ((const char*) arena_ + namePtr, (size_t) nameLen);
+}
+
+float NativeDSP::getParamDefault (int index)
+{
+    return initialized_.load() ? moonvst_get_param_default (index) : 0.0f;
+}
+
+float NativeDSP::getParamMin (int index)
+{
+    return initialized_.load() ? moonvst_get_param_min (index) : 0.0f;
+}
+
+float NativeDSP::getParamMax (int index)
+{
+    return initialized_.load() ? moonvst_get_param_max (index) : 1.0f;
+}
+
+void NativeDSP::setParam (int index, float value)
+{
+    if (initialized_.load())
+        moonvst_set_param (index, value);
+}
+
+float NativeDSP::getParam (int index)
+{
+    return initialized_.load() ? moonvst_get_param (index) : 0.0f;
+}
+
+DSPMemoryUsage NativeDSP::getMemoryUsage() const
+{
+    if (! initialized_.load())
+        return {};
+
+    // The native core runs on the host's stack and heap; the arena is its only
+    // dedicated allocation.
+    const auto arenaBytes = (size_t) moonvst_native_arena_size();
+    return { arenaBytes, arenaBytes };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "ParamBatchRelay.h"
+
+ParamBatchRelay::ParamBatchRelay (PluginProcessor& processor)
+    : processor_ (processor)
+{
+    const int count = processor_.getWasmParamCount();
+    parameters_.reserve ((size_t) count);
+    for (int i = 0; i < count; ++i)
+        parameters_.push_back (processor_.getWasmParameter (i));
+
+    dirty_ = std::make_unique<std::atomic<bool>[]> ((size_t) count);
+    for (int i = 0; i < count; ++i)
+        dirty_[(size_t) i].store (false);
+
+    subscribed_.assign ((size_t) count, false);
+}
+
+ParamBatchRelay::~ParamBatchRelay()
+{
+    for (size_t i = 0; i < parameters_.size(); ++i)
+    {
+        if (subscribed_[i] && parameters_[i] != nullptr)
+            parameters_[i]->removeListener (this);
+    }
+}
+
+void ParamBatchRelay::attach (juce::WebBrowserComponent& browser)
+{
+    browser_ = &browser;
+}
+
+juce::var ParamBatchRelay::subscribe (const juce::var& indices)
+{
+    juce::Array<juce::var> values;
+
+    if (const auto* requested = indices.getArray())
+    {
+        for (const auto& item : *requested)
+        {
+            const int index = (int) item;
+            if (index < 0 || index >= (int) parameters_.size() || parameters_[(size_t) index] == nullptr)
+                continue;
+
+            if (! subscribed_[(size_t) index])
+            {
+                subscribed_[(size_t) index] = true;
+                ++subscribedCount_;
+                parameters_[(size_t) index]->addListener (this);
+            }
+
+            values.add (makeEntry (index));
+        }
+    }
+
+    return values;
+}
+
+void ParamBatchRelay::flush()
+{
+    if (browser_ == nullptr || ! anyDirty_.exchange (false))
+        return;
+
+    juce::Array<juce::var> changes;
+    for (size_t i = 0; i < parameters_.size(); ++i)
+    {
+        if (dirty_[i].exchange (false))
+            changes.add (makeEntry ((int) i));
+    }
+
+    if (! changes.isEmpty())
+        browser_->emitEventIfBrowserIsVisible (eventId, juce::var (changes));
+}
+
+void ParamBatchRelay::parameterValueChanged (int parameterIndex, float)
+{
+    // May run on the audio thread during automation: flag only.
+    // APVTS registers parameters in WASM index order, so the processor
+    // parameter index is the WASM index.
+    if (parameterIndex < 0 || parameterIndex >= (int) parameters_.size())
+        return;
+
+    dirty_[(size_t) parameterIndex].store (true, std::memory_order_relaxed);
+    anyDirty_.store (true, std::memory_order_release);
+}
+
+juce::var ParamBatchRelay::makeEntry (int index) const
+{
+    const auto* param = parameters_[(size_t) index];
+    const float value = param != nullptr ? param->convertFrom0to1 (param->getValue()) : 0.0f;
+
+    juce::Array<juce::var> entry;
+    entry.add (index);
+    entry.add ((double) value);
+    return entry;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_gui_extra/juce_gui_extra.h>
+#include "PluginProcessor.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Single parameter bridge between the processor and the web UI.
+//
+// The UI subscribes to the parameter indices it actually displays; only
+// those get a parameter listener. Changes are flagged lock-free from any
+// thread and flushed as one "moonvst:params" event per display frame carrying
+// [index, value] pairs, instead of one WebSliderRelay event per parameter.
+class ParamBatchRelay : private juce::AudioProcessorParameter::Listener
+{
+public:
+    static constexpr const char* eventId = "moonvst:params";
+
+    explicit ParamBatchRelay (PluginProcessor&);
+    ~ParamBatchRelay() override;
+
+    void attach (juce::WebBrowserComponent& browser);
+
+    // Adds listeners for any not-yet-subscribed indices and returns the
+    // current values of all requested ones as [[index, value], ...].
+    juce::var subscribe (const juce::var& indices);
+
+    int getSubscribedCount() const { return subscribedCount_; }
+
+    // Sends any pending changes now. Called from the editor's frame tick.
+    void flush();
+
+private:
+    PluginProcessor& processor_;
+    juce::WebBrowserComponent* browser_ = nullptr;
+    std::vector<juce::RangedAudioParameter*> parameters_;
+    std::unique_ptr<std::atomic<bool>[]> dirty_;
+    std::vector<bool> subscribed_;
+    int subscribedCount_ = 0;
+    std::atomic<bool> anyDirty_ { false };
+
+    void parameterValueChanged (int parameterIndex, float newValue) override;
+    void parameterGestureChanged (int, bool) override {}
+
+    juce::var makeEntry (int index) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParamBatchRelay)
+};
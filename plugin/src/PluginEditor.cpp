@@ -1,6 +1,9 @@
 #include "PluginEditor.h"
 #include "UIBinaryData.h"
+#include "moonvst/Trace.h"
 #include <cstring>
+#include <string>
+#include <unordered_map>
 
 namespace
 {
@@ -24,7 +27,9 @@ DefaultEditorSize getDefaultEditorSize()
 
 juce::String normaliseResourcePath (juce::String path)
 {
-    path = path.replaceCharacter ('\\', '/').trim();
+    path = path.upToFirstOccurrenceOf ("?", false, false)
+               .upToFirstOccurrenceOf ("#", false, false)
+               .replaceCharacter ('\\', '/').trim();
     while (path.startsWithChar ('/'))
         path = path.substring (1);
 
@@ -54,6 +59,85 @@ juce::String getMimeTypeForPath (const juce::String& path)
     return "application/octet-stream";
 }
 
+struct UIResourceEntry
+{
+    std::vector<std::byte> bytes;
+    juce::String mimeType;
+};
+
+// Embedded UI assets keyed by normalised path and by basename. Built once per
+// process on first request; gzip-embedded assets (MOONVST_COMPRESS_UI_RESOURCES)
+// are inflated here so every later request is a lookup plus one copy into the
+// Resource that JUCE takes by value.
+class UIResourceIndex
+{
+public:
+    static const UIResourceIndex& getInstance()
+    {
+        static const UIResourceIndex index;
+        return index;
+    }
+
+    const UIResourceEntry* find (const juce::String& path) const
+    {
+        if (const auto it = byPath.find (path.toStdString()); it != byPath.end())
+            return &entries[it->second];
+
+        if (const auto it = byBasename.find (getPathBasename (path).toStdString()); it != byBasename.end())
+            return &entries[it->second];
+
+        return nullptr;
+    }
+
+private:
+    UIResourceIndex()
+    {
+        entries.reserve ((size_t) UIBinaryData::namedResourceListSize);
+
+        for (int i = 0; i < UIBinaryData::namedResourceListSize; ++i)
+        {
+            const auto* resourceName = UIBinaryData::namedResourceList[i];
+            const auto* originalName = UIBinaryData::getNamedResourceOriginalFilename (resourceName);
+            auto path = normaliseResourcePath (originalName != nullptr ? juce::String (originalName) : "");
+
+            int size = 0;
+            const auto* data = UIBinaryData::getNamedResource (resourceName, size);
+            if (data == nullptr || size <= 0)
+                continue;
+
+            UIResourceEntry entry;
+            if (path.endsWithIgnoreCase (".gz"))
+            {
+                path = path.dropLastCharacters (3);
+                juce::MemoryInputStream compressed (data, (size_t) size, false);
+                juce::GZIPDecompressorInputStream inflater (&compressed, false,
+                                                            juce::GZIPDecompressorInputStream::gzipFormat);
+                juce::MemoryBlock inflated;
+                inflater.readIntoMemoryBlock (inflated);
+                entry.bytes.resize (inflated.getSize());
+                std::memcpy (entry.bytes.data(), inflated.getData(), inflated.getSize());
+            }
+            else
+            {
+                entry.bytes.resize ((size_t) size);
+                std::memcpy (entry.bytes.data(), data, (size_t) size);
+            }
+
+            entry.mimeType = getMimeTypeForPath (path);
+            const auto entryIndex = entries.size();
+            entries.push_back (std::move (entry));
+
+            // emplace keeps the first registration, matching the old scan order.
+            byPath.emplace (path.toStdString(), entryIndex);
+            byBasename.emplace (getPathBasename (path).toStdString(), entryIndex);
+        }
+    }
+
+    std::vector<UIResourceEntry> entries;
+    std::unordered_map<std::string, size_t> byPath;
+    std::unordered_map<std::string, size_t> byBasename;
+};
+
 juce::String getWebViewFailureMessage()
 {
 #if JUCE_WINDOWS
@@ -84,11 +168,12 @@ PluginEditor::PluginEditor (PluginProcessor& p)
 
 PluginEditor::~PluginEditor()
 {
-    // Destroy WebView first while relay/listener objects are still alive.
-    // This avoids dangling WebViewLifetimeListener pointers during teardown.
+    // Destroy WebView first while the relay is still alive, so no native
+    // function call can recreate it against a dying browser.
+    frameTick.reset();
+    processorRef.getSpectrumAnalyzer().setActive (false);
     webView.reset();
-    sliderAttachments.clear();
-    sliderRelays.clear();
+    paramRelay.reset();
 }
 
 bool PluginEditor::setupWebView()
@@ -148,6 +233,7 @@ bool PluginEditor::setupWebView()
         })
         .withNativeFunction ("setParam", [this] (auto& args, auto complete)
         {
+            MOONVST_TRACE_SCOPE ("native.setParam");
             if (args.size() >= 2)
             {
                 int index = (int) args[0];
@@ -155,8 +241,7 @@ bool PluginEditor::setupWebView()
 
                 if (index >= 0 && index < processorRef.getWasmParamCount())
                 {
-                    auto& name = processorRef.getWasmParamName (index);
-                    if (auto* param = processorRef.getAPVTS().getParameter (name))
+                    if (auto* param = processorRef.getWasmParameter (index))
                     {
                         param->setValueNotifyingHost (
                             param->convertTo0to1 (value));
@@ -167,19 +252,31 @@ bool PluginEditor::setupWebView()
         })
         .withNativeFunction ("getParam", [this] (auto& args, auto complete)
         {
+            MOONVST_TRACE_SCOPE ("native.getParam");
             if (args.size() >= 1)
             {
                 int index = (int) args[0];
                 if (index >= 0 && index < processorRef.getWasmParamCount())
                 {
-                    auto& name = processorRef.getWasmParamName (index);
-                    float value = *processorRef.getAPVTS().getRawParameterValue (name);
-                    complete (juce::var ((double) value));
-                    return;
+                    if (auto* param = processorRef.getWasmParameter (index))
+                    {
+                        complete (juce::var ((double) param->convertFrom0to1 (param->getValue())));
+                        return;
+                    }
                 }
             }
             complete (juce::var (0.0));
         })
+        .withNativeFunction ("subscribeParams", [this] (auto& args, auto complete)
+        {
+            if (args.size() < 1 || webView == nullptr)
+            {
+                complete (juce::var (juce::Array<juce::var>()));
+                return;
+            }
+
+            complete (subscribeParams (args[0]));
+        })
         .withNativeFunction ("getLevel", [this] (auto& /*args*/, auto complete)
         {
             complete (juce::var ((double) processorRef.getOutputLevel()));
@@ -192,6 +289,62 @@ bool PluginEditor::setupWebView()
         {
             complete (juce::var (processorRef.getLatencyMs()));
         })
+        .withNativeFunction ("getMemoryUsage", [this] (auto& /*args*/, auto complete)
+        {
+            const auto usage = processorRef.getMemoryUsage();
+            auto* obj = new juce::DynamicObject();
+            obj->setProperty ("linearMemoryBytes", (double) usage.linearMemoryBytes);
+            obj->setProperty ("residentBytes", (double) usage.residentBytes);
+            complete (juce::var (obj));
+        })
+        .withNativeFunction ("startTrace", [] (auto& /*args*/, auto complete)
+        {
+           #if MOONVST_ENABLE_TRACE
+            complete (juce::var (moonvst::trace::startCapture()));
+           #else
+            complete (juce::var (false));
+           #endif
+        })
+        .withNativeFunction ("stopTrace", [] (auto& /*args*/, auto complete)
+        {
+            // Returns the path of the written Chrome trace, or "" when tracing
+            // is compiled out or no capture was running.
+           #if MOONVST_ENABLE_TRACE
+            const auto file = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                  .getNonexistentChildFile ("moonvst-trace", ".json", false);
+            if (moonvst::trace::stopCapture (file))
+            {
+                complete (juce::var (file.getFullPathName()));
+                return;
+            }
+           #endif
+            complete (juce::var (juce::String()));
+        })
+        .withNativeFunction ("getDspHealth", [this] (auto& /*args*/, auto complete)
+        {
+            const auto health = processorRef.getDspHealth();
+            auto* obj = new juce::DynamicObject();
+            obj->setProperty ("traps", (int) health.traps);
+            obj->setProperty ("overruns", (int) health.overruns);
+            obj->setProperty ("recoveries", (int) health.recoveries);
+            obj->setProperty ("faulted", health.faulted);
+            complete (juce::var (obj));
+        })
+        .withNativeFunction ("getDspBackend", [this] (auto& /*args*/, auto complete)
+        {
+            // "native", or "wasm-aot" / "wasm-llvm-jit" / "wasm-fast-jit" / "wasm-interp".
+            complete (juce::var (processorRef.getDSP().getBackendName()));
+        })
+        .withNativeFunction ("setFixedBlockProcessing", [this] (auto& args, auto complete)
+        {
+            if (args.size() >= 1)
+                processorRef.setFixedBlockProcessing ((bool) args[0]);
+            complete (juce::var (processorRef.isFixedBlockProcessing()));
+        })
+        .withNativeFunction ("getFixedBlockProcessing", [this] (auto& /*args*/, auto complete)
+        {
+            complete (juce::var (processorRef.isFixedBlockProcessing()));
+        })
         .withNativeFunction ("getUiState", [this] (auto& /*args*/, auto complete)
         {
             complete (juce::var (processorRef.getUiStateJson()));
@@ -211,21 +364,6 @@ bool PluginEditor::setupWebView()
         .withWinWebView2Options (webView2Options);
 #endif
 
-    // Create WebSliderRelay and bind each relay to the corresponding parameter.
-    int paramCount = processorRef.getWasmParamCount();
-    for (int i = 0; i < paramCount; ++i)
-    {
-        auto relayName = juce::String ("param_") + juce::String (i);
-        auto relay = std::make_unique<juce::WebSliderRelay> (relayName);
-        opts = opts.withOptionsFrom (*relay);
-
-        auto paramName = processorRef.getWasmParamName (i);
-        if (auto* param = processorRef.getAPVTS().getParameter (paramName))
-            sliderAttachments.push_back (std::make_unique<juce::WebSliderParameterAttachment> (*param, *relay));
-
-        sliderRelays.push_back (std::move (relay));
-    }
-
     const auto backendSupported = juce::WebBrowserComponent::areOptionsSupported (opts);
 
     if (! backendSupported)
@@ -234,6 +372,7 @@ bool PluginEditor::setupWebView()
     webView = std::make_unique<juce::WebBrowserComponent> (opts);
     addAndMakeVisible (*webView);
     webView->setBounds (getLocalBounds());
+    frameTick = std::make_unique<juce::VBlankAttachment> (this, [this] { pushFrameUpdates(); });
 
 #if JUCE_DEBUG
     // Debug mode: connect to Vite dev server
@@ -247,29 +386,76 @@ bool PluginEditor::setupWebView()
 
 std::optional<juce::WebBrowserComponent::Resource> PluginEditor::getUIResource (const juce::String& url) const
 {
-    const auto path = normaliseResourcePath (url);
-    const auto requestBasename = getPathBasename (path);
-    const auto mimeType = getMimeTypeForPath (path);
+    if (const auto* entry = UIResourceIndex::getInstance().find (normaliseResourcePath (url)))
+        return juce::WebBrowserComponent::Resource { entry->bytes, entry->mimeType };
 
-    for (int i = 0; i < UIBinaryData::namedResourceListSize; ++i)
+    return std::nullopt;
+}
+
+juce::var PluginEditor::subscribeParams (const juce::var& indices)
+{
+    // The relay is created on the first subscription, so an editor whose UI
+    // never subscribes adds no parameter listeners.
+    if (paramRelay == nullptr)
     {
-        const auto* resourceName = UIBinaryData::namedResourceList[i];
-        const auto* originalName = UIBinaryData::getNamedResourceOriginalFilename (resourceName);
-        const auto originalPath = normaliseResourcePath (originalName != nullptr ? juce::String (originalName) : "");
-        const auto originalBasename = getPathBasename (originalPath);
+        paramRelay = std::make_unique<ParamBatchRelay> (processorRef);
+        if (webView != nullptr)
+            paramRelay->attach (*webView);
+    }
 
-        if (path != originalPath && requestBasename != originalBasename)
-            continue;
+    return paramRelay->subscribe (indices);
+}
 
-        int size = 0;
-        if (const auto* data = UIBinaryData::getNamedResource (resourceName, size); data != nullptr && size > 0)
-        {
-            std::vector<std::byte> bytes ((size_t) size);
-            std::memcpy (bytes.data(), data, (size_t) size);
-            return juce::WebBrowserComponent::Resource { std::move (bytes), mimeType };
-        }
-    }
-    return std::nullopt;
+void PluginEditor::pushFrameUpdates()
+{
+    // VBlank callbacks keep arriving while the editor is hidden behind other
+    // windows or minimised; nothing is built or sent until it is showing again,
+    // and the spectrum analyzer stops capturing in the meantime.
+    const bool showing = webView != nullptr && isShowing();
+    processorRef.getSpectrumAnalyzer().setActive (showing);
+    if (! showing)
+        return;
+
+    MOONVST_TRACE_SCOPE ("editor.pushFrameUpdates");
+    if (paramRelay != nullptr)
+        paramRelay->flush();
+
+    pushSpectrum();
+
+    const auto telemetry = processorRef.getTelemetrySnapshot();
+    if (telemetrySent
+        && telemetry.processedBlocks == lastTelemetry.processedBlocks
+        && telemetry.latencyMs == lastTelemetry.latencyMs)
+        return;
+
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty ("level", (double) telemetry.outputLevel);
+    obj->setProperty ("cpuLoad", (double) telemetry.cpuLoad);
+    obj->setProperty ("latencyMs", telemetry.latencyMs);
+    const auto memory = processorRef.getMemoryUsage();
+    obj->setProperty ("linearMemoryBytes", (double) memory.linearMemoryBytes);
+    obj->setProperty ("residentBytes", (double) memory.residentBytes);
+    const auto health = processorRef.getDspHealth();
+    obj->setProperty ("traps", (int) health.traps);
+    obj->setProperty ("overruns", (int) health.overruns);
+    obj->setProperty ("recoveries", (int) health.recoveries);
+    obj->setProperty ("faulted", health.faulted);
+    webView->emitEventIfBrowserIsVisible ("moonvst:telemetry", juce::var (obj));
+
+    lastTelemetry = telemetry;
+    telemetrySent = true;
+}
+
+void PluginEditor::pushSpectrum()
+{
+    SpectrumAnalyzer::Frame frame;
+    if (! processorRef.getSpectrumAnalyzer().getFrameIfNewer (spectrumSequence, frame))
+        return;
+
+    // One byte per band, sent base64-encoded: a short string per frame
+    // instead of a JSON array of numbers.
+    webView->emitEventIfBrowserIsVisible ("moonvst:spectrum",
+                                          juce::Base64::toBase64 (frame.data(), frame.size()));
 }
 
 void PluginEditor::resized()
@@ -2,6 +2,7 @@
 
 #include <juce_gui_extra/juce_gui_extra.h>
 #include "PluginProcessor.h"
+#include "ParamBatchRelay.h"
 #include <vector>
 #include <memory>
 #include <optional>
@@ -14,15 +15,30 @@ public:
 
     void resized() override;
 
+    // Backs the UI's subscribeParams native function: listens to the given
+    // parameter indices and returns their current values as [[index, value], ...].
+    juce::var subscribeParams (const juce::var& indices);
+
+    // Number of parameters the UI has subscribed to (each holds one listener).
+    int getParamListenerCount() const { return paramRelay != nullptr ? paramRelay->getSubscribedCount() : 0; }
+
 private:
     PluginProcessor& processorRef;
 
     std::unique_ptr<juce::WebBrowserComponent> webView;
     juce::Label fallbackLabel;
 
-    // Dynamic WebSliderRelay storage for generic parameter bridging
-    std::vector<std::unique_ptr<juce::WebSliderRelay>> sliderRelays;
-    std::vector<std::unique_ptr<juce::WebSliderParameterAttachment>> sliderAttachments;
+    // Created on the UI's first subscribeParams call.
+    std::unique_ptr<ParamBatchRelay> paramRelay;
+
+    // Per-display-frame push of parameter changes and telemetry.
+    std::unique_ptr<juce::VBlankAttachment> frameTick;
+    TelemetrySnapshot lastTelemetry;
+    bool telemetrySent = false;
+    uint32_t spectrumSequence = 0;
+
+    void pushFrameUpdates();
+    void pushSpectrum();
 
     bool setupWebView();
     std::optional<juce::WebBrowserComponent::Resource> getUIResource (const juce::String& url) const;
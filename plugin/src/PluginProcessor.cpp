@@ -1,28 +1,84 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "PluginStateCodec.h"
+#include "moonvst/NativeDSP.h"
+#include "moonvst/Trace.h"
+#include "moonvst/WasmDSP.h"
+#include "moonvst/memory_layout_gen.h"
+#include <algorithm>
 #include <chrono>
+#include <limits>
+
+// Channel cap from the product's product.config.json "audio" block (see
+// plugin/CMakeLists.txt); 0 leaves the memory-layout contract's limit.
+#ifndef MOONVST_MAX_CHANNELS
+ #define MOONVST_MAX_CHANNELS 0
+#endif
+
+namespace
+{
+constexpr int kMaxBusChannels = (MOONVST_MAX_CHANNELS > 0
+                                 && MOONVST_MAX_CHANNELS < moonvst::memory_layout::MAX_CHANNELS)
+                                    ? MOONVST_MAX_CHANNELS
+                                    : moonvst::memory_layout::MAX_CHANNELS;
+
+// The showcase graph bank ("graph_*") carries the editor's graph through ~2k
+// parameters. They stay saved and settable but are not offered to the host
+// as automation targets.
+bool isGraphBankParam (const std::string& name)
+{
+    return name.rfind ("graph_", 0) == 0;
+}
+}
 
 PluginProcessor::PluginProcessor()
     : AudioProcessor (BusesProperties()
                           .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                           .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
+      dsp_ (createDSPBackend()),
       apvts (*this, nullptr, "Parameters", createParameterLayout())
 {
+    parameters_.reserve (paramNames_.size());
+    rawParameterValues_.reserve (paramNames_.size());
+    for (const auto& name : paramNames_)
+    {
+        parameters_.push_back (apvts.getParameter (name));
+        rawParameterValues_.push_back (apvts.getRawParameterValue (name));
+    }
+
+    sentParamValues_.assign (paramNames_.size(), std::numeric_limits<float>::quiet_NaN());
+    paramLayoutHash_ = PluginStateCodec::computeLayoutHash (paramNames_);
+    packedParamNames_ = PluginStateCodec::packParamNames (paramNames_);
 }
 
 PluginProcessor::~PluginProcessor()
 {
-    wasmDSP_.shutdown();
+    dsp_->shutdown();
+}
+
+std::unique_ptr<DSPBackend> PluginProcessor::createDSPBackend()
+{
+    // Native builds still carry WAMR: MOONVST_DSP_BACKEND=wasm forces the sandboxed
+    // engine, and any instance beyond the one that owns the native core falls back to it.
+    const auto requested = juce::SystemStats::getEnvironmentVariable ("MOONVST_DSP_BACKEND", {});
+    if (NativeDSP::isAvailable() && requested != "wasm")
+    {
+        auto native = std::make_unique<NativeDSP>();
+        if (native->initialize())
+            return native;
+    }
+
+    return std::make_unique<WasmDSP>();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout PluginProcessor::createParameterLayout()
 {
     juce::AudioProcessorValueTreeState::ParameterLayout layout;
-    wasmReady_ = wasmDSP_.initialize();
+    dspReady_ = dsp_->initialize();
 
-    if (wasmReady_)
+    if (dspReady_)
     {
-        const int wasmParamCount = wasmDSP_.getParamCount();
+        const int wasmParamCount = dsp_->getParamCount();
         if (wasmParamCount > 0)
         {
             paramCount_ = wasmParamCount;
@@ -31,13 +87,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout PluginProcessor::createParam
 
             for (int i = 0; i < paramCount_; ++i)
             {
-                auto name = wasmDSP_.getParamName (i);
+                auto name = dsp_->getParamName (i);
                 if (name.empty())
                     name = "param_" + std::to_string (i);
 
-                auto minVal = wasmDSP_.getParamMin (i);
-                auto maxVal = wasmDSP_.getParamMax (i);
-                auto defVal = wasmDSP_.getParamDefault (i);
+                auto minVal = dsp_->getParamMin (i);
+                auto maxVal = dsp_->getParamMax (i);
+                auto defVal = dsp_->getParamDefault (i);
 
                 if (maxVal <= minVal)
                     maxVal = minVal + 1.0f;
@@ -49,7 +105,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout PluginProcessor::createParam
                     juce::ParameterID { name, 1 },
                     name,
                     juce::NormalisableRange<float> (minVal, maxVal),
-                    defVal));
+                    defVal,
+                    juce::AudioParameterFloatAttributes().withAutomatable (! isGraphBankParam (name))));
             }
         }
     }
@@ -70,40 +127,92 @@ juce::AudioProcessorValueTreeState::ParameterLayout PluginProcessor::createParam
 
 void PluginProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    if (! wasmReady_)
-        wasmReady_ = wasmDSP_.initialize();
+    if (! dspReady_)
+        dspReady_ = dsp_->initialize();
 
     sampleRateHz_.store (sampleRate);
     blockSizeSamples_.store (samplesPerBlock);
-    wasmDSP_.prepare (sampleRate, samplesPerBlock);
+    spectrum_.prepare (sampleRate);
+
+    const int numChannels = juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+    for (auto& block : fixedBlockBuffers_)
+        block.setSize (numChannels, fixedBlockSamples);
+    fixedBlockActive_ = fixedBlockRequested_.load();
+    resetFixedBlockFifo();
+    setLatencySamples (fixedBlockActive_ ? fixedBlockSamples : 0);
+
+    // Prepared for both block sizes, so the mode can change without a re-prepare.
+    dsp_->setChannelLayout (getTotalNumInputChannels(), getTotalNumOutputChannels());
+    dsp_->prepare (sampleRate, juce::jmax (samplesPerBlock, fixedBlockSamples));
+    std::fill (sentParamValues_.begin(), sentParamValues_.end(), std::numeric_limits<float>::quiet_NaN());
+}
+
+void PluginProcessor::setFixedBlockProcessing (bool enabled)
+{
+    // The audio thread picks the change up at its next block and restarts the
+    // FIFO; the host hears about the latency change from here.
+    if (fixedBlockRequested_.exchange (enabled) != enabled)
+        setLatencySamples (enabled ? fixedBlockSamples : 0);
+}
+
+void PluginProcessor::resetFixedBlockFifo()
+{
+    for (auto& block : fixedBlockBuffers_)
+        block.clear();
+    fixedBlockFilling_ = 0;
+    fixedBlockFill_ = 0;
 }
 
 void PluginProcessor::releaseResources()
 {
 }
 
+bool PluginProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+    // In-place effect: any matching layout the product accepts, from mono up
+    // to 7.1.4 where the planar I/O contract has room, plus mono in / stereo
+    // out. Stereo stays the default.
+    const auto& input = layouts.getMainInputChannelSet();
+    const auto& output = layouts.getMainOutputChannelSet();
+    const bool monoToStereo = input == juce::AudioChannelSet::mono()
+                           && output == juce::AudioChannelSet::stereo();
+    return ! output.isDisabled()
+        && (input == output || monoToStereo)
+        && output.size() <= kMaxBusChannels;
+}
+
 void PluginProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
+    MOONVST_TRACE_SCOPE ("PluginProcessor::processBlock");
     juce::ScopedNoDenormals noDenormals;
     const auto blockStart = std::chrono::high_resolution_clock::now();
 
-    if (wasmReady_)
-    {
-        for (int i = 0; i < paramCount_; ++i)
-        {
-            if (const auto* raw = apvts.getRawParameterValue (paramNames_[(size_t) i]))
-                wasmDSP_.setParam (i, *raw);
-        }
+    // Output-only channels (mono in, stereo out) arrive holding garbage. Fill
+    // them with the mono input so a bypassed or faulted DSP still passes the
+    // dry signal to both sides; a running DSP overwrites them.
+    if (getTotalNumInputChannels() == 1)
+        for (int ch = 1; ch < getTotalNumOutputChannels(); ++ch)
+            buffer.copyFrom (ch, 0, buffer, 0, 0, buffer.getNumSamples());
 
-        wasmDSP_.processBlock (buffer);
+    const bool fixedBlock = fixedBlockRequested_.load (std::memory_order_relaxed);
+    if (fixedBlock != fixedBlockActive_)
+    {
+        fixedBlockActive_ = fixedBlock;
+        resetFixedBlockFifo();
     }
 
+    if (fixedBlockActive_)
+        processFixedBlocks (buffer);
+    else
+        processDspBlock (buffer);
+
     float peak = 0.0f;
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
     for (int ch = 0; ch < numChannels; ++ch)
         peak = juce::jmax (peak, buffer.getMagnitude (ch, 0, numSamples));
     outputLevel_.store (juce::jlimit (0.0f, 1.0f, peak));
+    spectrum_.push (buffer);
 
     const auto blockEnd = std::chrono::high_resolution_clock::now();
     const double processSec = std::chrono::duration<double> (blockEnd - blockStart).count();
@@ -116,6 +225,71 @@ void PluginProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::Midi
         const auto smoothed = static_cast<float> (prevCpuLoad * 0.85 + rawCpuLoad * 0.15);
         cpuLoad_.store (juce::jlimit (0.0f, 1.0f, smoothed));
     }
+
+    processedBlocks_.fetch_add (1, std::memory_order_relaxed);
+}
+
+void PluginProcessor::processDspBlock (juce::AudioBuffer<float>& block)
+{
+    if (! dspReady_)
+        return;
+
+    {
+        MOONVST_TRACE_SCOPE ("paramSync");
+        // Only changed values cross into the DSP: the showcase graph bank
+        // alone is ~2k parameters. A re-instantiated engine starts from its
+        // defaults, so a new recovery sends everything again.
+        const auto recoveries = dsp_->getHealth().recoveries;
+        if (recoveries != sentRecoveries_)
+        {
+            sentRecoveries_ = recoveries;
+            std::fill (sentParamValues_.begin(), sentParamValues_.end(), std::numeric_limits<float>::quiet_NaN());
+        }
+
+        for (int i = 0; i < paramCount_; ++i)
+        {
+            if (const auto* raw = rawParameterValues_[(size_t) i])
+            {
+                const float value = raw->load (std::memory_order_relaxed);
+                if (value != sentParamValues_[(size_t) i])
+                {
+                    sentParamValues_[(size_t) i] = value;
+                    dsp_->setParam (i, value);
+                }
+            }
+        }
+    }
+
+    dsp_->processBlock (block);
+}
+
+void PluginProcessor::processFixedBlocks (juce::AudioBuffer<float>& buffer)
+{
+    // Every sample waits exactly fixedBlockSamples: it is written at some
+    // position of the filling block and read back from the same position once
+    // that block has been processed and become the draining one.
+    const int numChannels = juce::jmin (buffer.getNumChannels(), fixedBlockBuffers_[0].getNumChannels());
+    const int numSamples = buffer.getNumSamples();
+    for (int pos = 0; pos < numSamples;)
+    {
+        auto& filling = fixedBlockBuffers_[fixedBlockFilling_];
+        const auto& draining = fixedBlockBuffers_[1 - fixedBlockFilling_];
+        const int chunk = juce::jmin (numSamples - pos, fixedBlockSamples - fixedBlockFill_);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            filling.copyFrom (ch, fixedBlockFill_, buffer, ch, pos, chunk);
+            buffer.copyFrom (ch, pos, draining, ch, fixedBlockFill_, chunk);
+        }
+
+        pos += chunk;
+        fixedBlockFill_ += chunk;
+        if (fixedBlockFill_ == fixedBlockSamples)
+        {
+            processDspBlock (filling);
+            fixedBlockFilling_ = 1 - fixedBlockFilling_;
+            fixedBlockFill_ = 0;
+        }
+    }
 }
 
 double PluginProcessor::getLatencyMs() const
@@ -130,6 +304,16 @@ double PluginProcessor::getLatencyMs() const
     return juce::jmax (0.0, latencyMs);
 }
 
+TelemetrySnapshot PluginProcessor::getTelemetrySnapshot() const
+{
+    TelemetrySnapshot snapshot;
+    snapshot.outputLevel = outputLevel_.load (std::memory_order_relaxed);
+    snapshot.cpuLoad = cpuLoad_.load (std::memory_order_relaxed);
+    snapshot.latencyMs = getLatencyMs();
+    snapshot.processedBlocks = processedBlocks_.load (std::memory_order_relaxed);
+    return snapshot;
+}
+
 juce::AudioProcessorEditor* PluginProcessor::createEditor()
 {
     return new PluginEditor (*this);
@@ -137,16 +321,67 @@ juce::AudioProcessorEditor* PluginProcessor::createEditor()
 
 void PluginProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
+    PluginStateData state;
+    state.layoutHash = paramLayoutHash_;
+    state.packedParamNames = packedParamNames_;
+    if (isFixedBlockProcessing())
+        state.flags |= PluginStateCodec::flagFixedBlockProcessing;
+    state.paramValues.resize (rawParameterValues_.size());
+    for (size_t i = 0; i < rawParameterValues_.size(); ++i)
+        state.paramValues[i] = rawParameterValues_[i] != nullptr ? rawParameterValues_[i]->load() : 0.0f;
+
     {
         const juce::ScopedLock lock (uiStateLock_);
-        state.setProperty ("uiStateJson", uiStateJson_, nullptr);
+        state.uiStateJson = uiStateJson_;
     }
-    std::unique_ptr<juce::XmlElement> xml (state.createXml());
-    copyXmlToBinary (*xml, destData);
+
+    PluginStateCodec::encode (state, destData);
 }
 
 void PluginProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    if (! PluginStateCodec::isBinaryState (data, sizeInBytes))
+    {
+        restoreLegacyXmlState (data, sizeInBytes);
+        return;
+    }
+
+    PluginStateData state;
+    if (! PluginStateCodec::decode (data, sizeInBytes, state))
+        return;
+
+    setFixedBlockProcessing ((state.flags & PluginStateCodec::flagFixedBlockProcessing) != 0);
+
+    const auto restore = [] (juce::RangedAudioParameter* param, float value)
+    {
+        if (param == nullptr)
+            return;
+
+        const auto normalised = param->convertTo0to1 (value);
+        if (param->getValue() != normalised)
+            param->setValueNotifyingHost (normalised);
+    };
+
+    if (state.layoutHash == paramLayoutHash_ && state.paramValues.size() == parameters_.size())
+    {
+        for (size_t i = 0; i < parameters_.size(); ++i)
+            restore (parameters_[i], state.paramValues[i]);
+    }
+    else
+    {
+        // The product's parameter set changed since the session was saved.
+        // Values are matched up by ID; parameters that no longer exist are
+        // dropped and new ones keep their current value. Version 1 states
+        // carry no IDs, so only their UI state comes back.
+        for (size_t i = 0; i < state.paramNames.size(); ++i)
+            restore (apvts.getParameter (juce::String (state.paramNames[i])), state.paramValues[i]);
+    }
+
+    const juce::ScopedLock lock (uiStateLock_);
+    uiStateJson_ = state.uiStateJson;
+}
+
+void PluginProcessor::restoreLegacyXmlState (const void* data, int sizeInBytes)
 {
     std::unique_ptr<juce::XmlElement> xml (getXmlFromBinary (data, sizeInBytes));
     if (xml != nullptr && xml->hasTagName (apvts.state.getType()))
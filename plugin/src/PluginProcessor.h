@@ -1,10 +1,23 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
-#include "moonvst/WasmDSP.h"
+#include "moonvst/DSPBackend.h"
+#include "SpectrumAnalyzer.h"
 #include <vector>
 #include <string>
 #include <atomic>
+#include <memory>
+
+// Values the editor pushes to the UI once per display frame. Each field is
+// published independently through an atomic, so taking a snapshot never
+// blocks the audio thread.
+struct TelemetrySnapshot
+{
+    float outputLevel = 0.0f;
+    float cpuLoad = 0.0f;
+    double latencyMs = 0.0;
+    uint32_t processedBlocks = 0;
+};
 
 class PluginProcessor : public juce::AudioProcessor
 {
@@ -15,6 +28,7 @@ public:
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -33,31 +47,71 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    WasmDSP& getWasmDSP() { return wasmDSP_; }
+    DSPBackend& getDSP() { return *dsp_; }
     int getWasmParamCount() const { return paramCount_; }
     const std::string& getWasmParamName (int index) const { return paramNames_[index]; }
+    juce::RangedAudioParameter* getWasmParameter (int index) const { return parameters_[(size_t) index]; }
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
     const juce::AudioProcessorValueTreeState& getAPVTS() const { return apvts; }
     float getOutputLevel() const { return outputLevel_.load(); }
     float getCpuLoad() const { return cpuLoad_.load(); }
     double getLatencyMs() const;
+    TelemetrySnapshot getTelemetrySnapshot() const;
+    DSPMemoryUsage getMemoryUsage() const { return dsp_->getMemoryUsage(); }
+    DSPHealth getDspHealth() const { return dsp_->getHealth(); }
+    SpectrumAnalyzer& getSpectrumAnalyzer() { return spectrum_; }
     void setUiStateJson(const juce::String& stateJson);
     juce::String getUiStateJson() const;
 
+    // Fixed-block mode rebuffers host audio through a FIFO into blocks of
+    // fixedBlockSamples before it reaches the DSP, so tiny host buffers pay
+    // the per-call overhead (parameter sync, copies, graph sync) once per
+    // internal block. Adds fixedBlockSamples of reported latency. Per
+    // instance and saved with the plugin state; call from the message thread.
+    static constexpr int fixedBlockSamples = 128;
+    void setFixedBlockProcessing (bool enabled);
+    bool isFixedBlockProcessing() const { return fixedBlockRequested_.load(); }
+
 private:
-    WasmDSP wasmDSP_;
-    bool wasmReady_ = false;
+    std::unique_ptr<DSPBackend> dsp_;
+    bool dspReady_ = false;
     int paramCount_ = 0;
     std::vector<std::string> paramNames_;
     juce::AudioProcessorValueTreeState apvts;
+    // Resolved once after the APVTS exists so the audio thread and state
+    // restore can address parameters by WASM index instead of by name.
+    std::vector<juce::RangedAudioParameter*> parameters_;
+    std::vector<std::atomic<float>*> rawParameterValues_;
+    uint32_t paramLayoutHash_ = 0;
+    juce::MemoryBlock packedParamNames_;
+    // Last value handed to the DSP per parameter (NaN = resend), audio thread
+    // only once prepared; see processDspBlock.
+    std::vector<float> sentParamValues_;
+    uint32_t sentRecoveries_ = 0;
     std::atomic<float> outputLevel_ { 0.0f };
     std::atomic<float> cpuLoad_ { 0.0f };
+    std::atomic<uint32_t> processedBlocks_ { 0 };
     std::atomic<double> sampleRateHz_ { 0.0 };
     std::atomic<int> blockSizeSamples_ { 0 };
     juce::String uiStateJson_;
     mutable juce::CriticalSection uiStateLock_;
+    SpectrumAnalyzer spectrum_;
+
+    // Fixed-block FIFO, audio thread only apart from the requested flag. One
+    // buffer fills with host input while the other, holding the previous
+    // processed block, drains to the host output.
+    std::atomic<bool> fixedBlockRequested_ { false };
+    bool fixedBlockActive_ = false;
+    juce::AudioBuffer<float> fixedBlockBuffers_[2];
+    int fixedBlockFilling_ = 0;
+    int fixedBlockFill_ = 0;
 
+    static std::unique_ptr<DSPBackend> createDSPBackend();
+    void processDspBlock (juce::AudioBuffer<float>& block);
+    void processFixedBlocks (juce::AudioBuffer<float>& buffer);
+    void resetFixedBlockFifo();
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    void restoreLegacyXmlState (const void* data, int sizeInBytes);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginProcessor)
 };
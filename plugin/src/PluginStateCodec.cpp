@@ -0,0 +1,172 @@
+#include "PluginStateCodec.h"
+
+namespace
+{
+constexpr int headerBytesV1 = 4 + 2 + 2 + 4 + 4 + 4 + 4;
+constexpr int headerBytes = headerBytesV1 + 4;
+constexpr int maxParamCount = 1 << 20;
+constexpr int maxUiJsonBytes = 64 * 1024 * 1024;
+constexpr int maxParamNameBytes = 256;
+
+void writeCompressed (juce::MemoryBlock& dest, const void* data, size_t size)
+{
+    juce::MemoryOutputStream compressedStream (dest, false);
+    juce::GZIPCompressorOutputStream zipStream (compressedStream);
+    zipStream.write (data, size);
+    zipStream.flush();
+}
+
+// Splits a decompressed ID table; false unless it holds exactly `count`
+// NUL-terminated names.
+bool unpackParamNames (const void* data, int compressedBytes, int count, std::vector<std::string>& names)
+{
+    juce::MemoryInputStream compressedStream (data, (size_t) compressedBytes, false);
+    juce::GZIPDecompressorInputStream zipStream (compressedStream);
+    juce::MemoryBlock table;
+    zipStream.readIntoMemoryBlock (table, (juce::int64) count * (maxParamNameBytes + 1));
+
+    names.clear();
+    names.reserve ((size_t) count);
+    const auto* chars = static_cast<const char*> (table.getData());
+    size_t start = 0;
+    for (size_t i = 0; i < table.getSize(); ++i)
+    {
+        if (chars[i] != 0)
+            continue;
+        names.emplace_back (chars + start, i - start);
+        start = i + 1;
+    }
+
+    return start == table.getSize() && names.size() == (size_t) count;
+}
+}
+
+uint32_t PluginStateCodec::computeLayoutHash (const std::vector<std::string>& paramNames)
+{
+    uint32_t hash = 2166136261u;
+    for (const auto& name : paramNames)
+    {
+        for (const auto c : name)
+        {
+            hash ^= (uint8_t) c;
+            hash *= 16777619u;
+        }
+
+        // Name separator, so {"ab", "c"} and {"a", "bc"} hash differently.
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+juce::MemoryBlock PluginStateCodec::packParamNames (const std::vector<std::string>& paramNames)
+{
+    std::string table;
+    for (const auto& name : paramNames)
+        table.append (name.c_str(), name.size() + 1);
+
+    juce::MemoryBlock packed;
+    writeCompressed (packed, table.data(), table.size());
+    return packed;
+}
+
+bool PluginStateCodec::isBinaryState (const void* data, int sizeInBytes)
+{
+    return data != nullptr
+        && sizeInBytes >= headerBytesV1
+        && juce::ByteOrder::littleEndianInt (data) == magic;
+}
+
+void PluginStateCodec::encode (const PluginStateData& state, juce::MemoryBlock& destData)
+{
+    juce::MemoryBlock compressedUi;
+    const auto uiJson = state.uiStateJson.toRawUTF8();
+    const auto uiJsonBytes = state.uiStateJson.getNumBytesAsUTF8();
+    if (uiJsonBytes > 0)
+        writeCompressed (compressedUi, uiJson, uiJsonBytes);
+
+    const auto paramCount = state.paramValues.size();
+    const auto& packedNames = state.packedParamNames;
+    destData.setSize ((size_t) headerBytes + paramCount * sizeof (float) + packedNames.getSize()
+                      + compressedUi.getSize());
+
+    juce::MemoryOutputStream out (destData, false);
+    out.writeInt ((int) magic);
+    out.writeShort ((short) currentVersion);
+    out.writeShort ((short) state.flags);
+    out.writeInt ((int) paramCount);
+    out.writeInt ((int) state.layoutHash);
+    out.writeInt ((int) uiJsonBytes);
+    out.writeInt ((int) compressedUi.getSize());
+    out.writeInt ((int) packedNames.getSize());
+
+    for (const auto value : state.paramValues)
+        out.writeFloat (value);
+
+    out.write (packedNames.getData(), packedNames.getSize());
+    out.write (compressedUi.getData(), compressedUi.getSize());
+    out.flush();
+}
+
+bool PluginStateCodec::decode (const void* data, int sizeInBytes, PluginStateData& state)
+{
+    if (! isBinaryState (data, sizeInBytes))
+        return false;
+
+    juce::MemoryInputStream in (data, (size_t) sizeInBytes, false);
+    in.readInt();
+    const auto version = (uint16_t) in.readShort();
+    const auto flags = (uint16_t) in.readShort();
+    const auto paramCount = in.readInt();
+    const auto layoutHash = (uint32_t) in.readInt();
+    const auto uiJsonBytes = in.readInt();
+    const auto uiJsonCompressedBytes = in.readInt();
+
+    if (version == 0 || version > currentVersion)
+        return false;
+
+    const auto paramNamesCompressedBytes = version >= 2 ? in.readInt() : 0;
+
+    if (paramCount < 0 || paramCount > maxParamCount
+        || uiJsonBytes < 0 || uiJsonBytes > maxUiJsonBytes || uiJsonCompressedBytes < 0
+        || paramNamesCompressedBytes < 0)
+        return false;
+
+    const auto expectedBytes = (juce::int64) (version >= 2 ? headerBytes : headerBytesV1)
+                             + (juce::int64) paramCount * (juce::int64) sizeof (float)
+                             + paramNamesCompressedBytes
+                             + uiJsonCompressedBytes;
+    if (expectedBytes > sizeInBytes)
+        return false;
+
+    state.layoutHash = layoutHash;
+    state.flags = flags;
+    state.paramValues.resize ((size_t) paramCount);
+    for (auto& value : state.paramValues)
+        value = in.readFloat();
+
+    state.paramNames.clear();
+    if (paramNamesCompressedBytes > 0)
+    {
+        if (! unpackParamNames (static_cast<const char*> (data) + in.getPosition(),
+                                paramNamesCompressedBytes, paramCount, state.paramNames))
+            return false;
+        in.skipNextBytes (paramNamesCompressedBytes);
+    }
+
+    state.uiStateJson = {};
+    if (uiJsonBytes > 0 && uiJsonCompressedBytes > 0)
+    {
+        juce::MemoryInputStream compressedStream (static_cast<const char*> (data) + in.getPosition(),
+                                                  (size_t) uiJsonCompressedBytes, false);
+        juce::GZIPDecompressorInputStream zipStream (compressedStream);
+
+        juce::HeapBlock<char> uiJson ((size_t) uiJsonBytes);
+        if (zipStream.read (uiJson.get(), uiJsonBytes) != uiJsonBytes)
+            return false;
+
+        state.uiStateJson = juce::String::fromUTF8 (uiJson.get(), uiJsonBytes);
+    }
+
+    return true;
+}
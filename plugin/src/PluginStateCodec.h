@@ -0,0 +1,55 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Versioned binary plugin state.
+//
+// Layout (little-endian):
+//   u32 magic 'MVSB' | u16 version | u16 flags | u32 paramCount | u32 layoutHash
+//   u32 uiJsonBytes | u32 uiJsonCompressedBytes
+//   u32 paramNamesCompressedBytes   (version 2+)
+//   f32[paramCount]                 denormalised parameter values, in WASM index order
+//   u8[paramNamesCompressedBytes]   zlib-compressed parameter IDs, each NUL-terminated,
+//                                   in the same order (version 2+)
+//   u8[uiJsonCompressedBytes]       zlib-compressed UTF-8 UI state JSON
+//
+// flags carries per-instance processing options (PluginStateCodec::flag*);
+// unknown bits are ignored on load.
+//
+// The showcase graph travels through the parameter bank, so the packed float
+// block doubles as the graph blob; nothing graph-specific is re-encoded.
+struct PluginStateData
+{
+    uint32_t layoutHash = 0;
+    uint16_t flags = 0;
+    std::vector<float> paramValues;
+    // Parameter IDs for paramValues. encode() writes packedParamNames (from
+    // packParamNames, built once per layout); decode() fills paramNames, which
+    // stays empty for version 1 states.
+    juce::MemoryBlock packedParamNames;
+    std::vector<std::string> paramNames;
+    juce::String uiStateJson;
+};
+
+class PluginStateCodec
+{
+public:
+    static constexpr uint32_t magic = 0x4253564d; // "MVSB"
+    static constexpr uint16_t currentVersion = 2;
+    static constexpr uint16_t flagFixedBlockProcessing = 1 << 0;
+
+    // FNV-1a over the ordered parameter names. Restoring by index is only
+    // safe when the saved layout hash matches the running one; otherwise
+    // values are matched up by the IDs stored with them.
+    static uint32_t computeLayoutHash (const std::vector<std::string>& paramNames);
+
+    // Compressed ID table for PluginStateData::packedParamNames.
+    static juce::MemoryBlock packParamNames (const std::vector<std::string>& paramNames);
+
+    static bool isBinaryState (const void* data, int sizeInBytes);
+    static void encode (const PluginStateData& state, juce::MemoryBlock& destData);
+    static bool decode (const void* data, int sizeInBytes, PluginStateData& state);
+};
@@ -0,0 +1,171 @@
+#include "SpectrumAnalyzer.h"
+#include "moonvst/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+// About one display frame; new frames are only computed when audio arrived.
+constexpr int kAnalysisIntervalMs = 16;
+
+// Magnitude of a full-scale sine after the Hann window (coherent gain 0.5).
+constexpr float kFullScaleMagnitude = (float) SpectrumAnalyzer::fftSize * 0.25f;
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : fifoBuffer_ ((size_t) fifoSamples, 0.0f),
+      history_ ((size_t) fftSize, 0.0f),
+      fftData_ ((size_t) fftSize * 2, 0.0f)
+{
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    if (! thread_.joinable())
+        return;
+
+    {
+        const std::lock_guard<std::mutex> lock (threadMutex_);
+        threadStop_ = true;
+    }
+    threadWake_.notify_all();
+    thread_.join();
+}
+
+void SpectrumAnalyzer::prepare (double sampleRate)
+{
+    if (sampleRate > 0.0)
+        sampleRate_.store (sampleRate);
+}
+
+void SpectrumAnalyzer::push (const juce::AudioBuffer<float>& buffer) noexcept
+{
+    if (! active_.load (std::memory_order_relaxed))
+        return;
+
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = juce::jmin (buffer.getNumSamples(), fifo_.getFreeSpace());
+    if (numChannels == 0 || numSamples <= 0)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo_.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+    const float gain = 1.0f / (float) numChannels;
+    const auto mixInto = [&] (float* dest, int sourceStart, int count)
+    {
+        juce::FloatVectorOperations::copyWithMultiply (dest, buffer.getReadPointer (0, sourceStart), gain, count);
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::addWithMultiply (dest, buffer.getReadPointer (ch, sourceStart), gain, count);
+    };
+    if (size1 > 0)
+        mixInto (fifoBuffer_.data() + start1, 0, size1);
+    if (size2 > 0)
+        mixInto (fifoBuffer_.data() + start2, size1, size2);
+
+    fifo_.finishedWrite (size1 + size2);
+}
+
+void SpectrumAnalyzer::setActive (bool active)
+{
+    active_.store (active, std::memory_order_relaxed);
+    if (active && ! thread_.joinable())
+        thread_ = std::thread ([this] { run(); });
+}
+
+bool SpectrumAnalyzer::getFrameIfNewer (uint32_t& lastSequence, Frame& frame) const
+{
+    const std::lock_guard<std::mutex> lock (frameMutex_);
+    if (frameSequence_ == lastSequence)
+        return false;
+
+    frame = frame_;
+    lastSequence = frameSequence_;
+    return true;
+}
+
+void SpectrumAnalyzer::run()
+{
+    std::unique_lock<std::mutex> lock (threadMutex_);
+    while (! threadWake_.wait_for (lock, std::chrono::milliseconds (kAnalysisIntervalMs),
+                                   [this] { return threadStop_; }))
+    {
+        if (! active_.load (std::memory_order_relaxed) || fifo_.getNumReady() == 0)
+            continue;
+
+        lock.unlock();
+        analyse();
+        lock.lock();
+    }
+}
+
+void SpectrumAnalyzer::drainFifo()
+{
+    // Slides whatever arrived since the last frame into the analysis window,
+    // keeping only the newest fftSize samples.
+    int start1, size1, start2, size2;
+    fifo_.prepareToRead (fifo_.getNumReady(), start1, size1, start2, size2);
+
+    const auto append = [this] (const float* source, int count)
+    {
+        if (count <= 0)
+            return;
+        if (count >= fftSize)
+        {
+            std::copy (source + count - fftSize, source + count, history_.begin());
+            return;
+        }
+        std::copy (history_.begin() + count, history_.end(), history_.begin());
+        std::copy (source, source + count, history_.end() - count);
+    };
+    append (fifoBuffer_.data() + start1, size1);
+    append (fifoBuffer_.data() + start2, size2);
+
+    fifo_.finishedRead (size1 + size2);
+}
+
+void SpectrumAnalyzer::updateBandEdges (double sampleRate)
+{
+    // Band b covers [minHz * r^b, minHz * r^(b+1)) with r = (maxHz / minHz)^(1 / numBands).
+    // Every band keeps at least one bin, so the lowest bands repeat bins at
+    // small FFT sizes instead of going blank.
+    const double binHz = sampleRate / fftSize;
+    const double ratio = std::pow ((double) maxHz / minHz, 1.0 / numBands);
+    double edgeHz = minHz;
+    for (int band = 0; band <= numBands; ++band)
+    {
+        bandEdges_[(size_t) band] = juce::jlimit (1, fftSize / 2, (int) std::lround (edgeHz / binHz));
+        edgeHz *= ratio;
+    }
+    bandSampleRate_ = sampleRate;
+}
+
+void SpectrumAnalyzer::analyse()
+{
+    MOONVST_TRACE_SCOPE ("spectrum.analyse");
+    drainFifo();
+
+    const double sampleRate = sampleRate_.load();
+    if (sampleRate != bandSampleRate_)
+        updateBandEdges (sampleRate);
+
+    std::copy (history_.begin(), history_.end(), fftData_.begin());
+    window_.multiplyWithWindowingTable (fftData_.data(), (size_t) fftSize);
+    fft_.performFrequencyOnlyForwardTransform (fftData_.data(), true);
+
+    Frame frame;
+    for (int band = 0; band < numBands; ++band)
+    {
+        const int first = bandEdges_[(size_t) band];
+        const int last = juce::jmax (first + 1, bandEdges_[(size_t) band + 1]);
+        const auto peak = *std::max_element (fftData_.begin() + first,
+                                             fftData_.begin() + juce::jmin (last, fftSize / 2 + 1));
+        const float db = juce::Decibels::gainToDecibels (peak / kFullScaleMagnitude, floorDb);
+        frame[(size_t) band] = (uint8_t) juce::jlimit (0, 255, (int) std::lround ((db - floorDb) / -floorDb * 255.0f));
+    }
+
+    const std::lock_guard<std::mutex> lock (frameMutex_);
+    frame_ = frame;
+    ++frameSequence_;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Output spectrum feed for the editor.
+//
+// The audio thread mixes each processed block down to mono into a lock-free
+// single-producer FIFO. A background thread slides the newest fftSize
+// samples into a Hann window, runs the FFT and reduces it to numBands
+// log-spaced bands between minHz and maxHz, each quantised to 0-255 over
+// floorDb..0 dBFS. Nothing is captured or computed while the analyzer is
+// inactive; the editor activates it only while it is showing.
+class SpectrumAnalyzer
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBands = 64;
+    static constexpr float minHz = 20.0f;
+    static constexpr float maxHz = 20000.0f;
+    static constexpr float floorDb = -90.0f;
+
+    using Frame = std::array<uint8_t, numBands>;
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer();
+
+    void prepare (double sampleRate);
+
+    // Audio thread. Drops samples when the FIFO is full rather than blocking.
+    void push (const juce::AudioBuffer<float>& buffer) noexcept;
+
+    // Message thread. The analysis thread starts on first activation and
+    // idles while inactive.
+    void setActive (bool active);
+    bool isActive() const { return active_.load (std::memory_order_relaxed); }
+
+    // Copies the newest frame into frame if it is newer than lastSequence,
+    // and advances lastSequence.
+    bool getFrameIfNewer (uint32_t& lastSequence, Frame& frame) const;
+
+private:
+    static constexpr int fifoSamples = 4 * fftSize;
+
+    juce::AbstractFifo fifo_ { fifoSamples };
+    std::vector<float> fifoBuffer_;
+    std::atomic<bool> active_ { false };
+    std::atomic<double> sampleRate_ { 48000.0 };
+
+    // Analysis thread only.
+    juce::dsp::FFT fft_ { fftOrder };
+    juce::dsp::WindowingFunction<float> window_ { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> history_;
+    std::vector<float> fftData_;
+    std::array<int, numBands + 1> bandEdges_ {};
+    double bandSampleRate_ = 0.0;
+
+    mutable std::mutex frameMutex_;
+    Frame frame_ {};
+    uint32_t frameSequence_ = 0;
+
+    std::thread thread_;
+    std::mutex threadMutex_;
+    std::condition_variable threadWake_;
+    bool threadStop_ = false;
+
+    void run();
+    void analyse();
+    void drainFifo();
+    void updateBandEdges (double sampleRate);
+
+    JUCE_DECLARE_NON_COPYABLE (SpectrumAnalyzer)
+};
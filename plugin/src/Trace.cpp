@@ -0,0 +1,255 @@
+#include "moonvst/Trace.h"
+
+#if MOONVST_ENABLE_TRACE
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace moonvst::trace
+{
+namespace
+{
+// 16 threads x 8192 events x 24 bytes = 3 MB of rings, touched only once a
+// thread records its first event. A ring that fills up between drains drops
+// events and counts them instead of blocking the writer.
+constexpr int kMaxThreads = kMaxTracedThreads;
+constexpr uint32_t kRingCapacity = 8192;
+constexpr int kDrainIntervalMs = 10;
+
+static_assert ((kRingCapacity & (kRingCapacity - 1)) == 0, "ring capacity must be a power of two");
+
+// The thread id sits in what would otherwise be padding. A ring outlives the
+// thread that leased it, so events still waiting to be drained keep the id
+// of the thread that recorded them.
+struct Event
+{
+    const char* name;
+    int64_t timestampNs;
+    int32_t thread;
+    char phase;
+};
+
+static_assert (sizeof (Event) == 24, "the ring sizing above assumes 24-byte events");
+
+struct Ring
+{
+    std::atomic<bool> leased { false };
+    int32_t thread = 0;                // id of the leasing thread; written only by it
+    std::atomic<uint32_t> head { 0 }; // written by the leasing thread
+    std::atomic<uint32_t> tail { 0 }; // written by the drain thread
+    std::atomic<uint32_t> dropped { 0 };
+    std::array<Event, kRingCapacity> events;
+};
+
+Ring rings[kMaxThreads];
+std::atomic<int32_t> nextThreadId { 0 };
+std::atomic<uint32_t> untracedEvents { 0 };
+std::atomic<bool> capturing { false };
+
+// Session state, owned by whoever holds sessionMutex.
+std::mutex sessionMutex;
+std::thread drainThread;
+std::atomic<bool> drainStop { false };
+std::vector<Event> collected;
+int64_t captureStartNs = 0;
+
+int64_t nowNs() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A thread's hold on one ring, taken on its first event while capturing and
+// handed back when the thread exits, so hosts that spin worker threads up
+// and down do not run out of rings. The next owner continues from the ring's
+// head; the acquire on `leased` orders it after the previous owner's writes.
+class RingLease
+{
+public:
+    ~RingLease()
+    {
+        if (ring_ != nullptr)
+            ring_->leased.store (false, std::memory_order_release);
+    }
+
+    // Retried on every event while all rings are leased.
+    Ring* get() noexcept
+    {
+        if (ring_ == nullptr)
+            ring_ = claim();
+        return ring_;
+    }
+
+private:
+    static Ring* claim() noexcept
+    {
+        for (auto& ring : rings)
+        {
+            if (ring.leased.load (std::memory_order_relaxed))
+                continue;
+            bool expected = false;
+            if (ring.leased.compare_exchange_strong (expected, true, std::memory_order_acquire))
+            {
+                ring.thread = nextThreadId.fetch_add (1, std::memory_order_relaxed);
+                return &ring;
+            }
+        }
+        return nullptr;
+    }
+
+    Ring* ring_ = nullptr;
+};
+
+Ring* threadRing() noexcept
+{
+    thread_local RingLease lease;
+    return lease.get();
+}
+
+void record (const char* name, char phase) noexcept
+{
+    if (! capturing.load (std::memory_order_relaxed))
+        return;
+
+    auto* ring = threadRing();
+    if (ring == nullptr)
+    {
+        untracedEvents.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto head = ring->head.load (std::memory_order_relaxed);
+    if (head - ring->tail.load (std::memory_order_acquire) >= kRingCapacity)
+    {
+        ring->dropped.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->events[head & (kRingCapacity - 1)] = { name, nowNs(), ring->thread, phase };
+    ring->head.store (head + 1, std::memory_order_release);
+}
+
+void drainRings()
+{
+    for (auto& ring : rings)
+    {
+        const auto head = ring.head.load (std::memory_order_acquire);
+        for (auto tail = ring.tail.load (std::memory_order_relaxed); tail != head; ++tail)
+            collected.push_back (ring.events[tail & (kRingCapacity - 1)]);
+        ring.tail.store (head, std::memory_order_release);
+    }
+}
+
+void discardPendingEvents()
+{
+    for (auto& ring : rings)
+    {
+        ring.tail.store (ring.head.load (std::memory_order_acquire), std::memory_order_release);
+        ring.dropped.store (0, std::memory_order_relaxed);
+    }
+    untracedEvents.store (0, std::memory_order_relaxed);
+}
+
+std::string toChromeTraceJson()
+{
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    char line[256];
+
+    uint32_t dropped = 0;
+    for (const auto& ring : rings)
+        dropped += ring.dropped.load (std::memory_order_relaxed);
+
+    std::vector<int32_t> threads;
+    for (const auto& event : collected)
+        threads.push_back (event.thread);
+    std::sort (threads.begin(), threads.end());
+    threads.erase (std::unique (threads.begin(), threads.end()), threads.end());
+    for (const auto thread : threads)
+    {
+        std::snprintf (line, sizeof (line),
+                       "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}},\n",
+                       thread, thread);
+        json += line;
+    }
+
+    for (const auto& event : collected)
+    {
+        const double timestampUs = (double) (event.timestampNs - captureStartNs) / 1000.0;
+        // Instant events are thread-scoped ("s":"t") so they draw on their own track.
+        std::snprintf (line, sizeof (line),
+                       "{\"name\":\"%s\",\"ph\":\"%c\",%s\"ts\":%.3f,\"pid\":1,\"tid\":%d},\n",
+                       event.name,
+                       event.phase,
+                       event.phase == 'i' ? "\"s\":\"t\"," : "",
+                       timestampUs,
+                       event.thread);
+        json += line;
+    }
+
+    std::snprintf (line, sizeof (line),
+                   "{\"name\":\"dropped_events\",\"ph\":\"C\",\"ts\":0,\"pid\":1,\"args\":{\"count\":%u,\"untraced\":%u}}\n]}\n",
+                   dropped,
+                   untracedEvents.load (std::memory_order_relaxed));
+    json += line;
+    return json;
+}
+}
+
+void begin (const char* name) noexcept { record (name, 'B'); }
+void end (const char* name) noexcept { record (name, 'E'); }
+void instant (const char* name) noexcept { record (name, 'i'); }
+
+bool isCapturing() noexcept
+{
+    return capturing.load (std::memory_order_relaxed);
+}
+
+bool startCapture()
+{
+    const std::lock_guard<std::mutex> lock (sessionMutex);
+    if (capturing.load())
+        return false;
+
+    discardPendingEvents();
+    collected.clear();
+    captureStartNs = nowNs();
+    drainStop.store (false);
+    capturing.store (true);
+
+    drainThread = std::thread ([]
+    {
+        while (! drainStop.load())
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (kDrainIntervalMs));
+            drainRings();
+        }
+    });
+    return true;
+}
+
+bool stopCapture (const juce::File& destination)
+{
+    const std::lock_guard<std::mutex> lock (sessionMutex);
+    if (! capturing.load())
+        return false;
+
+    capturing.store (false);
+    drainStop.store (true);
+    drainThread.join();
+    drainRings();
+
+    const auto json = toChromeTraceJson();
+    collected.clear();
+    collected.shrink_to_fit();
+    return destination.replaceWithData (json.data(), json.size());
+}
+}
+
+#endif
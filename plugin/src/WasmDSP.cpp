@@ -1,16 +1,50 @@
 #include "moonvst/WasmDSP.h"
 #include "BinaryData.h"
+#include "moonvst/Trace.h"
+#include "moonvst/WasmPerfMap.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <mutex>
+#include <thread>
+
+const char* WasmDSP::getExecutionModeName (WasmExecutionMode mode)
+{
+    switch (mode)
+    {
+        case WasmExecutionMode::aot:         return "aot";
+        case WasmExecutionMode::llvmJit:     return "llvm-jit";
+        case WasmExecutionMode::fastJit:     return "fast-jit";
+        case WasmExecutionMode::interpreter: return "interp";
+    }
+    return "unknown";
+}
+
+WasmExecutionMode WasmDSP::getDefaultExecutionMode()
+{
+    const auto requested = juce::SystemStats::getEnvironmentVariable ("MOONVST_WASM_MODE", {});
+    if (requested == "jit")
+        return WasmExecutionMode::llvmJit;
+    if (requested == "fast-jit")
+        return WasmExecutionMode::fastJit;
+    if (requested == "interp")
+        return WasmExecutionMode::interpreter;
+    return WasmExecutionMode::aot;
+}
 
 #if MOONVST_DISABLE_WASM_DSP
 
-WasmDSP::WasmDSP() = default;
+WasmDSP::WasmDSP (WasmExecutionMode preferredMode)
+    : preferredMode_ (preferredMode), activeMode_ (preferredMode) {}
 WasmDSP::~WasmDSP() = default;
 
+bool WasmDSP::isExecutionModeSupported (WasmExecutionMode) { return false; }
+const char* WasmDSP::getBackendName() const { return "wasm"; }
 bool WasmDSP::initialize() { return false; }
 void WasmDSP::shutdown() {}
 void WasmDSP::prepare (double, int) {}
+void WasmDSP::setChannelLayout (int, int) {}
 void WasmDSP::processBlock (juce::AudioBuffer<float>&) {}
 int WasmDSP::getParamCount() { return 0; }
 std::string WasmDSP::getParamName (int) { return ""; }
@@ -19,12 +53,102 @@ float WasmDSP::getParamMin (int) { return 0.0f; }
 float WasmDSP::getParamMax (int) { return 1.0f; }
 void WasmDSP::setParam (int, float) {}
 float WasmDSP::getParam (int) { return 0.0f; }
+DSPMemoryUsage WasmDSP::getMemoryUsage() const { return {}; }
+DSPHealth WasmDSP::getHealth() const { return {}; }
+void WasmDSP::forceTrapForTesting() {}
+void WasmDSP::startWatchdog() {}
+void WasmDSP::stopWatchdog() {}
+void WasmDSP::pollWatchdog (int64_t) {}
+void WasmDSP::handleCallFailure() {}
+bool WasmDSP::reinstantiate() { return false; }
+bool WasmDSP::callPrepare() { return false; }
+bool WasmDSP::loadInstance (WasmExecutionMode) { return false; }
+bool WasmDSP::instantiateModule (WasmExecutionMode) { return false; }
+void WasmDSP::releaseModuleInstance() {}
+void WasmDSP::releaseInstance() {}
 bool WasmDSP::lookupFunctions() { return false; }
+void WasmDSP::refreshMemoryUsage() {}
 
 #else
 
+// Instance sizing comes from the product's product.config.json "runtime" block
+// (see plugin/CMakeLists.txt); these fallbacks match its defaults.
+#ifndef MOONVST_WASM_STACK_BYTES
+ #define MOONVST_WASM_STACK_BYTES 524288
+#endif
+#ifndef MOONVST_WASM_HEAP_BYTES
+ #define MOONVST_WASM_HEAP_BYTES 0
+#endif
+#ifndef MOONVST_WASM_EXEC_ENV_STACK_BYTES
+ #define MOONVST_WASM_EXEC_ENV_STACK_BYTES 65536
+#endif
+
 namespace
 {
+constexpr uint32_t kInstanceStackBytes = MOONVST_WASM_STACK_BYTES;
+constexpr uint32_t kInstanceHeapBytes = MOONVST_WASM_HEAP_BYTES;
+constexpr uint32_t kExecEnvStackBytes = MOONVST_WASM_EXEC_ENV_STACK_BYTES;
+
+#if MOONVST_WASM_PERF_MAP
+// Module name WAMR tags perf map entries with, distinct per product so two
+// MoonVST plugins profiled in one host stay apart.
+ #ifdef MOONVST_PRODUCT_NAME
+constexpr const char* kPerfMapModuleName = "moonvst_" MOONVST_PRODUCT_NAME;
+ #else
+constexpr const char* kPerfMapModuleName = "moonvst_dsp";
+ #endif
+#endif
+
+// Watchdog: a block may run for this many block durations (but at least the
+// minimum) before the watchdog terminates it. One thread polls every instance. Faulted instances are rebuilt
+// after a backoff that doubles with every fault that follows a recovery too
+// closely, so a deterministic trap does not spin the watchdog thread.
+constexpr int kWatchdogPollMs = 2;
+constexpr int kWatchdogBudgetBlocks = 4;
+constexpr int64_t kWatchdogMinBudgetNs = 20 * 1000 * 1000;
+constexpr int kRecoveryBaseDelayMs = 100;
+constexpr int kRecoveryMaxBackoffShift = 6;
+constexpr uint32_t kHealthyBlocksAfterRecovery = 256;
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+RunningMode toRunningMode (WasmExecutionMode mode)
+{
+    switch (mode)
+    {
+        case WasmExecutionMode::llvmJit: return Mode_LLVM_JIT;
+        case WasmExecutionMode::fastJit: return Mode_Fast_JIT;
+        default:                         return Mode_Interp;
+    }
+}
+
+// Embedded DSP payloads, found by original file extension in BinaryData.
+struct EmbeddedModule
+{
+    const char* data = nullptr;
+    int size = 0;
+};
+
+EmbeddedModule findEmbeddedModule (const char* extension)
+{
+    for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
+    {
+        const char* name = BinaryData::namedResourceList[i];
+        const char* originalName = BinaryData::getNamedResourceOriginalFilename (name);
+        if (originalName == nullptr || ! juce::String (originalName).endsWithIgnoreCase (extension))
+            continue;
+
+        int size = 0;
+        if (const char* data = BinaryData::getNamedResource (name, size); data != nullptr && size > 0)
+            return { data, size };
+    }
+    return {};
+}
+
 bool ensureRuntimeInitialized()
 {
     static std::once_flag once;
@@ -35,16 +159,31 @@ bool ensureRuntimeInitialized()
         RuntimeInitArgs initArgs;
         std::memset (&initArgs, 0, sizeof (initArgs));
         initArgs.mem_alloc_type = Alloc_With_System_Allocator;
+       #if MOONVST_WASM_PERF_MAP
+        initArgs.enable_linux_perf = moonvst::perf_map::isRequested();
+       #endif
         initialized = wasm_runtime_full_init (&initArgs);
     });
 
     return initialized;
 }
 
-class ScopedThreadEnv
+// WAMR needs a thread environment (stack boundary, signal stack) on every
+// thread that calls into a module. Setting one up maps memory under the
+// process-wide mmap lock, so it is done once per thread and kept until the
+// thread exits; hosts that spread instances across a pool of audio threads
+// would otherwise pay it on every call.
+class ThreadEnv
 {
 public:
-    ScopedThreadEnv()
+    static bool ensure()
+    {
+        thread_local const ThreadEnv env;
+        return env.valid_;
+    }
+
+private:
+    ThreadEnv()
     {
         if (wasm_runtime_thread_env_inited())
         {
@@ -56,15 +195,12 @@ public:
         valid_ = owned_;
     }
 
-    ~ScopedThreadEnv()
+    ~ThreadEnv()
     {
         if (owned_)
             wasm_runtime_destroy_thread_env();
     }
 
-    bool isValid() const { return valid_; }
-
-private:
     bool owned_ = false;
     bool valid_ = false;
 };
@@ -97,75 +233,164 @@ bool callF32 (wasm_exec_env_t execEnv, wasm_function_inst_t fn,
 }
 }
 
-WasmDSP::WasmDSP() = default;
+WasmDSP::WasmDSP (WasmExecutionMode preferredMode)
+    : preferredMode_ (preferredMode), activeMode_ (preferredMode)
+{
+}
 
 WasmDSP::~WasmDSP()
 {
     shutdown();
 }
 
-bool WasmDSP::initialize()
+bool WasmDSP::isExecutionModeSupported (WasmExecutionMode mode)
 {
-    if (initialized_.load())
+    if (mode == WasmExecutionMode::aot)
         return true;
 
-#if MOONVST_DISABLE_WASM_DSP
-    return false;
-#endif
-
-    // WAMR signal handlers are process-wide. Keep runtime alive for the process lifetime.
-    if (! ensureRuntimeInitialized())
-        return false;
+    return ensureRuntimeInitialized() && wasm_runtime_is_running_mode_supported (toRunningMode (mode));
+}
 
-    // Load AOT binary from embedded resource
-    // BinaryData contains the .aot file compiled from MoonBit WASM
-    const char* aotData = nullptr;
-    int aotSize = 0;
+const char* WasmDSP::getBackendName() const
+{
+    if (! initialized_.load())
+        return "wasm";
 
-    // Look for the AOT binary in BinaryData
-    for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
+    switch (activeMode_)
     {
-        int size = 0;
-        const char* data = BinaryData::getNamedResource (BinaryData::namedResourceList[i], size);
-        if (data != nullptr && size > 0)
-        {
-            aotData = data;
-            aotSize = size;
-            break;
-        }
+        case WasmExecutionMode::aot:         return "wasm-aot";
+        case WasmExecutionMode::llvmJit:     return "wasm-llvm-jit";
+        case WasmExecutionMode::fastJit:     return "wasm-fast-jit";
+        case WasmExecutionMode::interpreter: return "wasm-interp";
     }
+    return "wasm";
+}
+
+bool WasmDSP::loadInstance (WasmExecutionMode mode)
+{
+    const bool isAot = mode == WasmExecutionMode::aot;
+    if (! isExecutionModeSupported (mode))
+        return false;
 
-    if (aotData == nullptr || aotSize == 0)
+    const auto embedded = findEmbeddedModule (isAot ? ".aot" : ".wasm");
+    if (embedded.data == nullptr)
         return false;
 
-    // Load AOT module
     char errorBuf[128];
-    module_ = wasm_runtime_load ((uint8_t*) aotData, (uint32_t) aotSize,
-                                  errorBuf, sizeof (errorBuf));
+    if (isAot)
+    {
+       #if MOONVST_WASM_PERF_MAP
+        // The embedded bytecode supplies the function names for the perf map.
+        const auto bytecode = findEmbeddedModule (".wasm");
+        module_ = moonvst::perf_map::loadAotModule ((uint8_t*) embedded.data, (uint32_t) embedded.size,
+                                                    (const uint8_t*) bytecode.data, (size_t) bytecode.size,
+                                                    kPerfMapModuleName, errorBuf, sizeof (errorBuf));
+       #else
+        module_ = wasm_runtime_load ((uint8_t*) embedded.data, (uint32_t) embedded.size,
+                                      errorBuf, sizeof (errorBuf));
+       #endif
+    }
+    else
+    {
+        bytecode_.assign ((const uint8_t*) embedded.data, (const uint8_t*) embedded.data + embedded.size);
+        module_ = wasm_runtime_load (bytecode_.data(), (uint32_t) bytecode_.size(),
+                                      errorBuf, sizeof (errorBuf));
+    }
     if (module_ == nullptr)
+    {
+        DBG ("WasmDSP: " << getExecutionModeName (mode) << " load failed: " << errorBuf);
+        releaseInstance();
         return false;
+    }
+
+    if (! instantiateModule (mode))
+    {
+        releaseInstance();
+        return false;
+    }
+
+    activeMode_ = mode;
+    return true;
+}
 
-    // Instantiate module (512KB stack, 64MB heap)
-    moduleInst_ = wasm_runtime_instantiate (module_, 512 * 1024, 64 * 1024 * 1024,
+bool WasmDSP::instantiateModule (WasmExecutionMode mode)
+{
+    char errorBuf[128];
+    moduleInst_ = wasm_runtime_instantiate (module_, kInstanceStackBytes, kInstanceHeapBytes,
                                              errorBuf, sizeof (errorBuf));
     if (moduleInst_ == nullptr)
     {
-        wasm_runtime_unload (module_);
-        module_ = nullptr;
+        DBG ("WasmDSP: " << getExecutionModeName (mode) << " instantiate failed: " << errorBuf);
+        return false;
+    }
+
+    if (mode != WasmExecutionMode::aot && ! wasm_runtime_set_running_mode (moduleInst_, toRunningMode (mode)))
+    {
+        releaseModuleInstance();
         return false;
     }
 
-    // Create execution environment
-    execEnv_ = wasm_runtime_create_exec_env (moduleInst_, 64 * 1024);
+    execEnv_ = wasm_runtime_create_exec_env (moduleInst_, kExecEnvStackBytes);
     if (execEnv_ == nullptr)
+    {
+        releaseModuleInstance();
+        return false;
+    }
+
+    return true;
+}
+
+void WasmDSP::releaseModuleInstance()
+{
+    if (execEnv_ != nullptr)
+    {
+        wasm_runtime_destroy_exec_env (execEnv_);
+        execEnv_ = nullptr;
+    }
+
+    if (moduleInst_ != nullptr)
     {
         wasm_runtime_deinstantiate (moduleInst_);
         moduleInst_ = nullptr;
+    }
+}
+
+void WasmDSP::releaseInstance()
+{
+    releaseModuleInstance();
+
+    if (module_ != nullptr)
+    {
         wasm_runtime_unload (module_);
         module_ = nullptr;
-        return false;
     }
 
+    bytecode_.clear();
+    bytecode_.shrink_to_fit();
+}
+
+bool WasmDSP::initialize()
+{
+    if (initialized_.load())
+        return true;
+
+#if MOONVST_DISABLE_WASM_DSP
+    return false;
+#endif
+
+    // WAMR signal handlers are process-wide. Keep runtime alive for the process lifetime.
+    if (! ensureRuntimeInitialized())
+        return false;
+
+    // Walk down from the preferred mode; an AOT image that fails to load
+    // (e.g. unsupported relocations) falls back to the embedded bytecode.
+    bool loaded = false;
+    for (int mode = (int) preferredMode_; mode <= (int) WasmExecutionMode::interpreter && ! loaded; ++mode)
+        loaded = loadInstance ((WasmExecutionMode) mode);
+
+    if (! loaded)
+        return false;
+
     // Lookup all generic functions
     if (! lookupFunctions())
     {
@@ -176,8 +401,7 @@ bool WasmDSP::initialize()
     // Call init()
     if (fn_init_ != nullptr)
     {
-        const ScopedThreadEnv threadEnv;
-        if (! threadEnv.isValid())
+        if (! ThreadEnv::ensure())
         {
             shutdown();
             return false;
@@ -192,33 +416,214 @@ bool WasmDSP::initialize()
 
     // Cache parameter count
     cachedParamCount_ = getParamCount();
+    refreshMemoryUsage();
 
+    state_.store (instanceRunning);
     initialized_.store (true);
+    startWatchdog();
     return true;
 }
 
 void WasmDSP::shutdown()
 {
+    stopWatchdog();
     initialized_.store (false);
+    linearMemoryBytes_.store (0);
+    releaseInstance();
+}
 
-    if (execEnv_ != nullptr)
+// One thread watches every instance in the process, so a session with
+// hundreds of plugin instances does not keep hundreds of sleeping threads.
+// Instances are polled under the registry lock: once remove() returns, the
+// thread is not inside that instance and never will be again. The thread
+// starts with the first instance and is joined when the last one leaves.
+// Rebuilds run here as well; they reuse the loaded module, so they hold up
+// the other instances' polls only for the length of one instantiate.
+class WasmDSP::Watchdog
+{
+public:
+    static Watchdog& get()
     {
-        wasm_runtime_destroy_exec_env (execEnv_);
-        execEnv_ = nullptr;
+        static Watchdog watchdog;
+        return watchdog;
     }
 
-    if (moduleInst_ != nullptr)
+    void add (WasmDSP* instance)
     {
-        wasm_runtime_deinstantiate (moduleInst_);
-        moduleInst_ = nullptr;
+        const std::lock_guard<std::mutex> lifecycle (lifecycleMutex_);
+        const std::lock_guard<std::mutex> lock (mutex_);
+        instances_.push_back (instance);
+        if (! thread_.joinable())
+        {
+            stop_ = false;
+            thread_ = std::thread ([this] { run(); });
+        }
     }
 
-    if (module_ != nullptr)
+    void remove (WasmDSP* instance)
     {
-        wasm_runtime_unload (module_);
-        module_ = nullptr;
+        // Held across the join so add() cannot start a second thread while
+        // the old one is still winding down.
+        const std::lock_guard<std::mutex> lifecycle (lifecycleMutex_);
+        {
+            const std::lock_guard<std::mutex> lock (mutex_);
+            instances_.erase (std::remove (instances_.begin(), instances_.end(), instance), instances_.end());
+            if (! instances_.empty() || ! thread_.joinable())
+                return;
+            stop_ = true;
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock (mutex_);
+        while (! wake_.wait_for (lock, std::chrono::milliseconds (kWatchdogPollMs), [this] { return stop_; }))
+        {
+            const auto now = nowNs();
+            for (auto* instance : instances_)
+                instance->pollWatchdog (now);
+        }
+    }
+
+    std::mutex lifecycleMutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<WasmDSP*> instances_;
+    std::thread thread_;
+    bool stop_ = false;
+};
+
+void WasmDSP::startWatchdog()
+{
+    consecutiveFaults_ = 0;
+    retryAtNs_ = 0;
+    blocksAtRecovery_ = 0;
+    Watchdog::get().add (this);
+    watched_ = true;
+}
+
+void WasmDSP::stopWatchdog()
+{
+    if (! watched_)
+        return;
+
+    Watchdog::get().remove (this);
+    watched_ = false;
+}
+
+void WasmDSP::pollWatchdog (int64_t now)
+{
+    if (state_.load (std::memory_order_acquire) == instanceRunning)
+    {
+        retryAtNs_ = 0;
+        if (consecutiveFaults_ > 0
+            && completedBlocks_.load (std::memory_order_relaxed) - blocksAtRecovery_ >= kHealthyBlocksAfterRecovery)
+            consecutiveFaults_ = 0;
+
+        // The audio thread is stuck inside the module: stop it at the next
+        // check point. The failed call then takes the fault path below.
+        const auto start = blockStartNs_.load (std::memory_order_acquire);
+        const auto budget = budgetNs_.load (std::memory_order_relaxed);
+        if (start != 0 && budget > 0 && now - start > budget && ! terminateRequested_.exchange (true))
+        {
+            overruns_.fetch_add (1, std::memory_order_relaxed);
+            MOONVST_TRACE_INSTANT ("wasm.terminate");
+            wasm_runtime_terminate (moduleInst_);
+        }
+        return;
+    }
+
+    if (retryAtNs_ == 0)
+    {
+        const int shift = juce::jmin (consecutiveFaults_, kRecoveryMaxBackoffShift);
+        retryAtNs_ = now + ((int64_t) kRecoveryBaseDelayMs << shift) * 1000 * 1000;
+        return;
+    }
+
+    if (now < retryAtNs_)
+        return;
+
+    ++consecutiveFaults_;
+    if (reinstantiate())
+    {
+        recoveries_.fetch_add (1, std::memory_order_relaxed);
+        blocksAtRecovery_ = completedBlocks_.load (std::memory_order_relaxed);
+        state_.store (instanceRunning, std::memory_order_release);
+    }
+    retryAtNs_ = 0;
+}
+
+void WasmDSP::handleCallFailure()
+{
+    // Called on the thread whose call failed. Overruns were already counted by
+    // the watchdog when it requested termination; the request is used up here
+    // so a later trap is not taken for one.
+    MOONVST_TRACE_INSTANT ("wasm.fault");
+    blockStartNs_.store (0, std::memory_order_release);
+    if (! terminateRequested_.exchange (false))
+        traps_.fetch_add (1, std::memory_order_relaxed);
+
+    state_.store (instanceFaulted, std::memory_order_release);
+}
+
+void WasmDSP::forceTrapForTesting()
+{
+    if (moduleInst_ != nullptr)
+        wasm_runtime_terminate (moduleInst_);
+}
+
+bool WasmDSP::reinstantiate()
+{
+    // Runs on the watchdog thread while the instance is faulted, so no other
+    // thread calls into it. The loaded module is reused; only the instance
+    // (linear memory, globals, exec env) is thrown away.
+    MOONVST_TRACE_SCOPE ("wasm.reinstantiate");
+    if (! ThreadEnv::ensure())
+        return false;
+
+    releaseModuleInstance();
+    sentInputChannels_ = 0;
+    sentOutputChannels_ = 0;
+    if (! instantiateModule (activeMode_) || ! lookupFunctions())
+    {
+        releaseModuleInstance();
+        return false;
     }
 
+    if (fn_init_ != nullptr && ! callVoid (execEnv_, fn_init_, nullptr, 0))
+        return false;
+
+    if (preparedSampleRate_.load() > 0.0 && ! callPrepare())
+        return false;
+
+    refreshMemoryUsage();
+    return true;
+}
+
+bool WasmDSP::callPrepare()
+{
+    if (fn_dsp_prepare_ == nullptr)
+        return true;
+
+    wasm_val_t args[2];
+    args[0].kind = WASM_F32;
+    args[0].of.f32 = (float) preparedSampleRate_.load();
+    args[1].kind = WASM_I32;
+    args[1].of.i32 = juce::jmin (preparedBlockSize_.load(), MAX_BUFFER_SAMPLES);
+    return callVoid (execEnv_, fn_dsp_prepare_, args, 2);
+}
+
+DSPHealth WasmDSP::getHealth() const
+{
+    DSPHealth health;
+    health.traps = traps_.load (std::memory_order_relaxed);
+    health.overruns = overruns_.load (std::memory_order_relaxed);
+    health.recoveries = recoveries_.load (std::memory_order_relaxed);
+    health.faulted = initialized_.load() && state_.load (std::memory_order_relaxed) != instanceRunning;
+    return health;
 }
 
 bool WasmDSP::lookupFunctions()
@@ -227,6 +632,7 @@ bool WasmDSP::lookupFunctions()
     if (fn_init_ == nullptr)
         fn_init_ = wasm_runtime_lookup_function (moduleInst_, "dsp_init");
     fn_dsp_prepare_        = wasm_runtime_lookup_function (moduleInst_, "dsp_prepare");
+    fn_set_channel_layout_ = wasm_runtime_lookup_function (moduleInst_, "dsp_set_channel_layout");
     fn_process_block_      = wasm_runtime_lookup_function (moduleInst_, "process_block");
     fn_get_param_count_    = wasm_runtime_lookup_function (moduleInst_, "get_param_count");
     fn_get_param_name_     = wasm_runtime_lookup_function (moduleInst_, "get_param_name");
@@ -241,65 +647,123 @@ bool WasmDSP::lookupFunctions()
     return fn_process_block_ != nullptr && fn_get_param_count_ != nullptr;
 }
 
-void WasmDSP::prepare (double sampleRate, int /*samplesPerBlock*/)
+void WasmDSP::prepare (double sampleRate, int samplesPerBlock)
 {
-    if (! initialized_.load() || fn_dsp_prepare_ == nullptr)
+    // Remembered even while faulted so a rebuilt instance is prepared the same way.
+    preparedSampleRate_.store (sampleRate);
+    preparedBlockSize_.store (samplesPerBlock);
+    if (sampleRate > 0.0 && samplesPerBlock > 0)
+        budgetNs_.store (juce::jmax (kWatchdogMinBudgetNs,
+                                     (int64_t) (kWatchdogBudgetBlocks * 1.0e9 * samplesPerBlock / sampleRate)),
+                         std::memory_order_relaxed);
+
+    if (! initialized_.load() || state_.load (std::memory_order_acquire) != instanceRunning)
         return;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    MOONVST_TRACE_SCOPE ("wasm.prepare");
+    if (! ThreadEnv::ensure())
         return;
 
-    wasm_val_t args[1];
-    args[0].kind = WASM_F32;
-    args[0].of.f32 = (float) sampleRate;
-    callVoid (execEnv_, fn_dsp_prepare_, args, 1);
+    if (! callPrepare())
+    {
+        handleCallFailure();
+        return;
+    }
+    refreshMemoryUsage();
+}
+
+void WasmDSP::setChannelLayout (int numInputChannels, int numOutputChannels)
+{
+    hostInputChannels_ = juce::jmax (0, numInputChannels);
+    hostOutputChannels_ = juce::jmax (0, numOutputChannels);
 }
 
 void WasmDSP::processBlock (juce::AudioBuffer<float>& buffer)
 {
-    if (! initialized_.load())
+    // While faulted the buffer is left holding the dry input.
+    if (! initialized_.load() || state_.load (std::memory_order_acquire) != instanceRunning)
         return;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return;
 
     const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
-
-    if (numSamples > MAX_BUFFER_SAMPLES)
+    // Modules built before the planar contract only know stereo. Channels past
+    // what the module handles are left untouched (dry).
+    const bool hasLayout = fn_set_channel_layout_ != nullptr;
+    const int maxChannels = hasLayout ? MAX_CHANNELS : 2;
+    const int bufferChannels = hostOutputChannels_ > 0 ? juce::jmin (hostOutputChannels_, buffer.getNumChannels())
+                                                       : buffer.getNumChannels();
+    const int numChannels = juce::jmin (bufferChannels, maxChannels);
+    const int numInputs = hasLayout && hostInputChannels_ > 0 ? juce::jlimit (1, numChannels, hostInputChannels_)
+                                                             : numChannels;
+
+    if (numSamples > MAX_BUFFER_SAMPLES || numChannels <= 0)
         return;
 
-    // Copy input to WASM linear memory
-    if (auto* wasmMemory = (uint8_t*) wasm_runtime_addr_app_to_native (moduleInst_, 0))
+    if (hasLayout && (numInputs != sentInputChannels_ || numChannels != sentOutputChannels_))
     {
-        if (numChannels >= 1)
-            std::memcpy (wasmMemory + INPUT_LEFT_OFFSET,
-                         buffer.getReadPointer (0),
-                         (size_t) numSamples * sizeof (float));
+        wasm_val_t layoutArgs[2];
+        layoutArgs[0].kind = WASM_I32;
+        layoutArgs[0].of.i32 = numInputs;
+        layoutArgs[1].kind = WASM_I32;
+        layoutArgs[1].of.i32 = numChannels;
+        if (! callVoid (execEnv_, fn_set_channel_layout_, layoutArgs, 2))
+        {
+            handleCallFailure();
+            return;
+        }
+        sentInputChannels_ = numInputs;
+        sentOutputChannels_ = numChannels;
+    }
 
-        if (numChannels >= 2)
-            std::memcpy (wasmMemory + INPUT_RIGHT_OFFSET,
-                         buffer.getReadPointer (1),
+    // Copy input to the planar input block in WASM linear memory. A mono input
+    // feeding a stereo output copies one channel; the DSP fans it out.
+    if (auto* wasmMemory = (uint8_t*) wasm_runtime_addr_app_to_native (moduleInst_, 0))
+    {
+        for (int ch = 0; ch < numInputs; ++ch)
+            std::memcpy (wasmMemory + moonvst::memory_layout::inputChannelOffset (ch),
+                         buffer.getReadPointer (ch),
                          (size_t) numSamples * sizeof (float));
 
         // Call process_block(numSamples)
         wasm_val_t args[1];
         args[0].kind = WASM_I32;
         args[0].of.i32 = numSamples;
-        if (! callVoid (execEnv_, fn_process_block_, args, 1))
+        blockStartNs_.store (nowNs(), std::memory_order_release);
+        bool processed;
+        {
+            MOONVST_TRACE_SCOPE ("wasm.process_block");
+            processed = callVoid (execEnv_, fn_process_block_, args, 1);
+        }
+        if (! processed)
+        {
+            // Output regions were never copied back, so the buffer is still dry.
+            handleCallFailure();
+            return;
+        }
+        blockStartNs_.store (0, std::memory_order_release);
+        if (terminateRequested_.exchange (false))
+        {
+            // The watchdog gave up on this block just as it finished. The
+            // output is good, but the exec env still carries the terminate
+            // and would fail the next call, so have the instance rebuilt.
+            state_.store (instanceFaulted, std::memory_order_release);
+        }
+        // Single writer: a plain store avoids a locked read-modify-write per block.
+        completedBlocks_.store (completedBlocks_.load (std::memory_order_relaxed) + 1,
+                                std::memory_order_relaxed);
+
+        // memory.grow inside process_block can resize (and move) linear memory.
+        refreshMemoryUsage();
+        wasmMemory = (uint8_t*) wasm_runtime_addr_app_to_native (moduleInst_, 0);
+        if (wasmMemory == nullptr)
             return;
 
-        // Copy output from WASM linear memory
-        if (numChannels >= 1)
-            std::memcpy (buffer.getWritePointer (0),
-                         wasmMemory + OUTPUT_LEFT_OFFSET,
-                         (size_t) numSamples * sizeof (float));
-
-        if (numChannels >= 2)
-            std::memcpy (buffer.getWritePointer (1),
-                         wasmMemory + OUTPUT_RIGHT_OFFSET,
+        // Copy output from the planar output block
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::memcpy (buffer.getWritePointer (ch),
+                         wasmMemory + moonvst::memory_layout::outputChannelOffset (ch),
                          (size_t) numSamples * sizeof (float));
     }
 }
@@ -309,8 +773,7 @@ int WasmDSP::getParamCount()
     if (fn_get_param_count_ == nullptr)
         return 0;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return 0;
 
     int32_t count = 0;
@@ -324,8 +787,7 @@ std::string WasmDSP::getParamName (int index)
     if (fn_get_param_name_ == nullptr || fn_get_param_name_len_ == nullptr)
         return "";
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return "";
 
     // Get name length
@@ -344,7 +806,7 @@ std::string WasmDSP::getParamName (int index)
     if (! callI32 (execEnv_, fn_get_param_name_, ptrArgs, 1, wasmPtr))
         return "";
 
-    if (wasmPtr == 0 || nameLen <= 0 || nameLen > 256)
+    if (wasmPtr == 0 || nameLen <= 0 || nameLen > moonvst::memory_layout::STRING_BUF_BYTES)
         return "";
 
     // Convert WASM address to native pointer
@@ -363,8 +825,7 @@ float WasmDSP::getParamDefault (int index)
     if (fn_get_param_default_ == nullptr)
         return 0.0f;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return 0.0f;
 
     wasm_val_t args[1];
@@ -382,8 +843,7 @@ float WasmDSP::getParamMin (int index)
     if (fn_get_param_min_ == nullptr)
         return 0.0f;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return 0.0f;
 
     wasm_val_t args[1];
@@ -401,8 +861,7 @@ float WasmDSP::getParamMax (int index)
     if (fn_get_param_max_ == nullptr)
         return 1.0f;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return 1.0f;
 
     wasm_val_t args[1];
@@ -417,11 +876,10 @@ float WasmDSP::getParamMax (int index)
 
 void WasmDSP::setParam (int index, float value)
 {
-    if (fn_set_param_ == nullptr)
+    if (fn_set_param_ == nullptr || state_.load (std::memory_order_acquire) != instanceRunning)
         return;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return;
 
     wasm_val_t args[2];
@@ -429,16 +887,36 @@ void WasmDSP::setParam (int index, float value)
     args[0].of.i32 = index;
     args[1].kind = WASM_F32;
     args[1].of.f32 = value;
-    callVoid (execEnv_, fn_set_param_, args, 2);
+    if (! callVoid (execEnv_, fn_set_param_, args, 2))
+        handleCallFailure();
+}
+
+void WasmDSP::refreshMemoryUsage()
+{
+    // Sampled on the thread that runs the module so readers never touch the
+    // instance while memory.grow might be in flight.
+    if (auto* memory = wasm_runtime_get_default_memory (moduleInst_))
+        linearMemoryBytes_.store ((size_t) wasm_memory_get_cur_page_count (memory)
+                                  * (size_t) wasm_memory_get_bytes_per_page (memory),
+                                  std::memory_order_relaxed);
+}
+
+DSPMemoryUsage WasmDSP::getMemoryUsage() const
+{
+    if (! initialized_.load())
+        return {};
+
+    const auto linearBytes = linearMemoryBytes_.load (std::memory_order_relaxed);
+    return { linearBytes,
+             linearBytes + (size_t) kInstanceStackBytes + (size_t) kInstanceHeapBytes + (size_t) kExecEnvStackBytes };
 }
 
 float WasmDSP::getParam (int index)
 {
-    if (fn_get_param_ == nullptr)
+    if (fn_get_param_ == nullptr || state_.load (std::memory_order_acquire) != instanceRunning)
         return 0.0f;
 
-    const ScopedThreadEnv threadEnv;
-    if (! threadEnv.isValid())
+    if (! ThreadEnv::ensure())
         return 0.0f;
 
     wasm_val_t args[1];
@@ -0,0 +1,278 @@
+#include "moonvst/WasmPerfMap.h"
+
+#if MOONVST_WASM_PERF_MAP
+
+#include <juce_core/juce_core.h>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unistd.h>
+
+namespace moonvst::perf_map
+{
+namespace
+{
+std::mutex loadMutex;
+
+// Bounds-checked reader for the parts of the binary format needed here. Any
+// read past the end clears ok instead of throwing.
+struct Reader
+{
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    uint8_t byte()
+    {
+        if (p >= end)
+        {
+            ok = false;
+            return 0;
+        }
+        return *p++;
+    }
+
+    uint32_t leb()
+    {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            const auto b = byte();
+            result |= (uint32_t) (b & 0x7f) << shift;
+            if ((b & 0x80) == 0)
+                return result;
+        }
+        ok = false;
+        return 0;
+    }
+
+    std::string name()
+    {
+        const auto length = leb();
+        if (! ok || (size_t) (end - p) < length)
+        {
+            ok = false;
+            return {};
+        }
+        std::string s ((const char*) p, length);
+        p += length;
+        return s;
+    }
+
+    void limits()
+    {
+        const auto flags = byte();
+        leb();
+        if ((flags & 1) != 0)
+            leb();
+    }
+};
+
+// Perf map symbols run to the end of the line; keep them one token.
+std::string sanitise (std::string symbol)
+{
+    for (auto& c : symbol)
+        if ((unsigned char) c <= ' ')
+            c = '_';
+    return symbol;
+}
+
+std::string perfMapPath()
+{
+    return "/tmp/perf-" + std::to_string ((long) getpid()) + ".map";
+}
+
+std::streamoff fileSize (const std::string& path)
+{
+    std::ifstream in (path, std::ios::binary | std::ios::ate);
+    return in ? (std::streamoff) in.tellg() : 0;
+}
+
+// Appends a named copy of every "aot_func#N" entry of moduleName written
+// after `from` bytes of the map. The file is shared with any other JIT in the
+// host process, so it is only ever appended to, in one O_APPEND write.
+void appendNamedEntries (const std::string& path, std::streamoff from, const std::string& moduleName,
+                         const std::vector<std::string>& names)
+{
+    std::string added;
+    {
+        std::ifstream in (path, std::ios::binary);
+        if (! in || ! in.seekg (from))
+            return;
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        added = buffer.str();
+    }
+
+    static constexpr const char* token = "aot_func#";
+    const auto tokenLength = std::strlen (token);
+    std::string named;
+    std::istringstream lines (added);
+    for (std::string line; std::getline (lines, line);)
+    {
+        const auto at = line.find (token);
+        if (at == std::string::npos || line.rfind (moduleName, at) == std::string::npos)
+            continue;
+
+        const auto digits = at + tokenLength;
+        auto digitsEnd = digits;
+        while (digitsEnd < line.size() && line[digitsEnd] >= '0' && line[digitsEnd] <= '9')
+            ++digitsEnd;
+        if (digitsEnd == digits || digitsEnd - digits > 9)
+            continue;
+
+        const auto index = std::stoul (line.substr (digits, digitsEnd - digits));
+        if (index < names.size() && ! names[index].empty())
+            named += line.substr (0, at) + names[index] + "\n";
+    }
+    if (named.empty())
+        return;
+
+    const int fd = ::open (path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd < 0)
+        return;
+    const auto written = ::write (fd, named.data(), named.size());
+    juce::ignoreUnused (written);
+    ::close (fd);
+}
+}
+
+bool isRequested()
+{
+    static const bool requested = []
+    {
+        const auto value = juce::SystemStats::getEnvironmentVariable ("MOONVST_PERF_MAP", {});
+        return value.isNotEmpty() && value != "0";
+    }();
+    return requested;
+}
+
+wasm_module_t loadAotModule (uint8_t* image, uint32_t imageSize,
+                             const uint8_t* bytecode, size_t bytecodeSize,
+                             const char* moduleName, char* errorBuf, uint32_t errorBufSize)
+{
+    LoadArgs args;
+    std::memset (&args, 0, sizeof (args));
+    args.name = const_cast<char*> (moduleName);
+
+    if (! isRequested())
+        return wasm_runtime_load_ex (image, imageSize, &args, errorBuf, errorBufSize);
+
+    const std::lock_guard<std::mutex> lock (loadMutex);
+    const auto path = perfMapPath();
+    const auto before = fileSize (path);
+
+    auto* module = wasm_runtime_load_ex (image, imageSize, &args, errorBuf, errorBufSize);
+    if (module != nullptr && bytecode != nullptr)
+        appendNamedEntries (path, before, moduleName, definedFunctionNames (bytecode, bytecodeSize));
+    return module;
+}
+
+std::vector<std::string> definedFunctionNames (const uint8_t* bytecode, size_t size)
+{
+    static constexpr uint8_t header[] = { 0x00, 'a', 's', 'm', 0x01, 0x00, 0x00, 0x00 };
+    if (size < sizeof (header) || std::memcmp (bytecode, header, sizeof (header)) != 0)
+        return {};
+
+    uint32_t importedFunctions = 0;
+    uint32_t definedFunctions = 0;
+    std::map<uint32_t, std::string> debugNames;
+    std::map<uint32_t, std::string> exportNames;
+
+    Reader reader { bytecode + sizeof (header), bytecode + size };
+    while (reader.ok && reader.p < reader.end)
+    {
+        const auto id = reader.byte();
+        const auto sectionSize = reader.leb();
+        if (! reader.ok || (size_t) (reader.end - reader.p) < sectionSize)
+            return {};
+
+        Reader section { reader.p, reader.p + sectionSize };
+        reader.p += sectionSize;
+
+        switch (id)
+        {
+            case 0: // custom: only the "name" section's function names
+            {
+                if (section.name() != "name")
+                    break;
+                while (section.ok && section.p < section.end)
+                {
+                    const auto subsection = section.byte();
+                    const auto subsectionSize = section.leb();
+                    if (! section.ok || (size_t) (section.end - section.p) < subsectionSize)
+                        break;
+
+                    Reader names { section.p, section.p + subsectionSize };
+                    section.p += subsectionSize;
+                    if (subsection != 1)
+                        continue;
+
+                    for (auto count = names.leb(); names.ok && count > 0; --count)
+                    {
+                        const auto index = names.leb();
+                        auto name = names.name();
+                        if (names.ok)
+                            debugNames[index] = std::move (name);
+                    }
+                }
+                break;
+            }
+
+            case 2: // imports: count function imports, skip the rest
+                for (auto count = section.leb(); section.ok && count > 0; --count)
+                {
+                    section.name();
+                    section.name();
+                    switch (section.byte())
+                    {
+                        case 0: section.leb(); ++importedFunctions; break;
+                        case 1: section.byte(); section.limits(); break;
+                        case 2: section.limits(); break;
+                        case 3: section.byte(); section.byte(); break;
+                        case 4: section.byte(); section.leb(); break;
+                        default: return {};
+                    }
+                }
+                break;
+
+            case 3: // functions
+                definedFunctions = section.leb();
+                break;
+
+            case 7: // exports
+                for (auto count = section.leb(); section.ok && count > 0; --count)
+                {
+                    auto name = section.name();
+                    const auto kind = section.byte();
+                    const auto index = section.leb();
+                    if (section.ok && kind == 0)
+                        exportNames.emplace (index, std::move (name));
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if (! section.ok)
+            return {};
+    }
+
+    std::vector<std::string> names (definedFunctions);
+    for (uint32_t i = 0; i < definedFunctions; ++i)
+    {
+        const auto index = importedFunctions + i;
+        if (const auto debug = debugNames.find (index); debug != debugNames.end())
+            names[i] = sanitise (debug->second);
+        else if (const auto exported = exportNames.find (index); exported != exportNames.end())
+            names[i] = sanitise (exported->second);
+    }
+    return names;
+}
+}
+
+#endif
@@ -382,6 +382,86 @@ describe('node editor shell layout', () => {
     })
   })
 
+  test('shows DSP memory usage reported by the juce runtime', async () => {
+    const runtime = {
+      type: 'juce' as const,
+      getParams: () => [],
+      setParam: () => {},
+      getParam: () => 0,
+      getLevel: () => 0,
+      getCpuLoad: () => 0.1,
+      getLatencyMs: () => 1,
+      getMemoryUsage: () => ({ linearMemoryBytes: 2 * 1024 * 1024, residentBytes: 2.5 * 1024 * 1024 }),
+      onParamChange: () => () => {},
+      invokeNative: vi.fn(async (name: string) => (name === 'getUiState' ? '' : undefined)),
+      dispose: () => {},
+    }
+
+    render(<NodeEditorShell runtime={runtime} />)
+
+    await vi.waitFor(() => {
+      expect(screen.getByText('Memory: 2.0 MB (2.5 MB resident)')).toBeInTheDocument()
+    })
+  })
+
+  test('shows DSP faults while the juce runtime is bypassed', async () => {
+    const runtime = {
+      type: 'juce' as const,
+      getParams: () => [],
+      setParam: () => {},
+      getParam: () => 0,
+      getLevel: () => 0,
+      getCpuLoad: () => 0.1,
+      getLatencyMs: () => 1,
+      getDspHealth: () => ({ traps: 1, overruns: 2, recoveries: 2, faulted: true }),
+      onParamChange: () => () => {},
+      invokeNative: vi.fn(async (name: string) => (name === 'getUiState' ? '' : undefined)),
+      dispose: () => {},
+    }
+
+    render(<NodeEditorShell runtime={runtime} />)
+
+    await vi.waitFor(() => {
+      expect(screen.getByText('DSP: bypassed (1 traps, 2 overruns, 2 recoveries)')).toBeInTheDocument()
+    })
+  })
+
+  test('shows web runtime startup timing when available', async () => {
+    const runtime = {
+      type: 'web' as const,
+      getParams: () => [],
+      setParam: () => {},
+      getParam: () => 0,
+      getLevel: () => 0,
+      getCpuLoad: () => 0,
+      getLatencyMs: () => 0,
+      getStartupTiming: () => ({
+        fetchMs: 4,
+        compileMs: 2,
+        instantiateMs: 1,
+        totalMs: 6,
+        audioReadyMs: 18.2,
+      }),
+      onParamChange: () => () => {},
+      dispose: () => {},
+      loadAudioData: async () => {},
+      loadAudioFile: async () => {},
+      play: async () => {},
+      stop: () => {},
+      startMic: async () => {},
+      stopMic: () => {},
+      hasAudioLoaded: () => false,
+      getIsPlaying: () => false,
+      getInputMode: () => 'none' as const,
+      getMicState: () => 'inactive' as const,
+    }
+
+    render(<NodeEditorShell runtime={runtime} />)
+    await vi.waitFor(() => {
+      expect(screen.getByText('Startup: 18 ms (compile 2 ms)')).toBeInTheDocument()
+    })
+  })
+
   test('falls back to placeholder metric values when runtime metrics are unavailable', async () => {
     const runtime = {
       type: 'web' as const,
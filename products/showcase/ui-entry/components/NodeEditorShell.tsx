@@ -20,7 +20,7 @@
 } from '../vendor/lucide'
 import '../styles/showcaseFonts'
 import { useEffect, useMemo, useRef, useState, type CSSProperties, type RefObject } from 'react'
-import type { AudioRuntime } from '../../../../packages/ui-core/src/runtime/types'
+import type { AudioRuntime, RuntimeDspHealth, RuntimeMemoryUsage, RuntimeStartupTiming } from '../../../../packages/ui-core/src/runtime/types'
 import { GraphCanvas } from './GraphCanvas'
 import { NodePalette } from './NodePalette'
 import { getNodeColor, getNodeLabel } from './graphUi'
@@ -32,7 +32,7 @@ import {
   getNodeParamValue,
   isEffectNodeKind,
 } from '../state/nodeParamSchema'
-import { createGraphRuntimeBridge, emitGraphPayloadToRuntime } from '../runtime/graphRuntimeBridge'
+import { createGraphRuntimeBridge, emitGraphWritesToRuntime } from '../runtime/graphRuntimeBridge'
 import {
   deserializeShowcaseUiState,
   graphStateFromPreset,
@@ -436,28 +436,57 @@ function InspectorPanel({
   )
 }
 
+function formatStartupTiming(timing: RuntimeStartupTiming): string {
+  const readyMs = timing.audioReadyMs ?? timing.totalMs
+  return `${readyMs.toFixed(0)} ms (compile ${timing.compileMs.toFixed(0)} ms)`
+}
+
+function formatBytes(bytes: number): string {
+  if (bytes >= 1024 * 1024) return `${(bytes / (1024 * 1024)).toFixed(1)} MB`
+  return `${(bytes / 1024).toFixed(0)} KB`
+}
+
+function formatMemoryUsage(usage: RuntimeMemoryUsage): string {
+  return `${formatBytes(usage.linearMemoryBytes)} (${formatBytes(usage.residentBytes)} resident)`
+}
+
+function formatDspHealth(health: RuntimeDspHealth): string | null {
+  if (!health.faulted && health.traps === 0 && health.overruns === 0) return null
+  const counts = `${health.traps} traps, ${health.overruns} overruns, ${health.recoveries} recoveries`
+  return health.faulted ? `bypassed (${counts})` : counts
+}
+
 function StatusBar({
   connectionCount,
   cpuLabel,
   cpuText,
+  faultText,
   lastError,
   latencyLabel,
   latencyText,
+  memoryText,
   nodeCount,
+  startupText,
 }: {
   connectionCount: number
   cpuLabel: string
   cpuText: string
+  faultText: string | null
   lastError: string | null
   latencyLabel: string
   latencyText: string
+  memoryText: string | null
   nodeCount: number
+  startupText: string | null
 }) {
   return (
     <footer aria-label="Status Bar" className={styles.statusBar} data-region-id="gkrb8">
       <div className={styles.statusLeft}>
         <span>{cpuLabel}: {cpuText}</span>
         <span>{latencyLabel}: {latencyText}</span>
+        {memoryText ? <span>Memory: {memoryText}</span> : null}
+        {startupText ? <span>Startup: {startupText}</span> : null}
+        {faultText ? <span>DSP: {faultText}</span> : null}
         <span>{lastError ?? 'Ready'}</span>
       </div>
       <div className={styles.statusRight}><span>{nodeCount} nodes | {connectionCount} connections</span><span className={styles.zoomBadge}><ZoomIn size={10} />100%</span></div>
@@ -502,10 +531,13 @@ export function NodeEditorShell({ runtime = null }: { runtime?: AudioRuntime | n
   const [isHydrationPending, setHydrationPending] = useState(() => runtime?.type === 'juce' || hasJuceBridge())
   const [cpuLoad, setCpuLoad] = useState<number | null>(null)
   const [latencyMs, setLatencyMs] = useState<number | null>(null)
+  const [startupText, setStartupText] = useState<string | null>(null)
+  const [memoryText, setMemoryText] = useState<string | null>(null)
+  const [faultText, setFaultText] = useState<string | null>(null)
   const graphRuntimeBridge = useMemo(
     () =>
-      createGraphRuntimeBridge((payload, revision) => {
-        emitGraphPayloadToRuntime(runtime, payload, revision)
+      createGraphRuntimeBridge((writes) => {
+        emitGraphWritesToRuntime(runtime, writes)
       }),
     [runtime],
   )
@@ -623,7 +655,7 @@ export function NodeEditorShell({ runtime = null }: { runtime?: AudioRuntime | n
     if (runtime?.type === 'juce' && runtime.invokeNative) {
       const payload = JSON.stringify({
         version: 1,
-        graphPayload: graphRuntimeBridge.sync(state),
+        graphPayload: graphRuntimeBridge.serialize(state),
         lastPresetName: presetName,
       })
       void runtime.invokeNative('setUiState', payload)
@@ -826,12 +858,21 @@ export function NodeEditorShell({ runtime = null }: { runtime?: AudioRuntime | n
       if (!runtime) {
         setCpuLoad(null)
         setLatencyMs(null)
+        setStartupText(null)
+        setMemoryText(null)
+        setFaultText(null)
         return
       }
       const nextCpuLoad = runtime.getCpuLoad?.()
       setCpuLoad(Number.isFinite(nextCpuLoad) ? (nextCpuLoad as number) : null)
       const nextLatency = runtime.getLatencyMs?.()
       setLatencyMs(Number.isFinite(nextLatency) ? (nextLatency as number) : null)
+      const startup = runtime.getStartupTiming?.()
+      setStartupText(startup ? formatStartupTiming(startup) : null)
+      const memory = runtime.getMemoryUsage?.()
+      setMemoryText(memory ? formatMemoryUsage(memory) : null)
+      const health = runtime.getDspHealth?.()
+      setFaultText(health ? formatDspHealth(health) : null)
     }
     refreshMetrics()
     const timerId = window.setInterval(refreshMetrics, 100)
@@ -992,13 +1033,16 @@ export function NodeEditorShell({ runtime = null }: { runtime?: AudioRuntime | n
         connectionCount={state.edges.length}
         cpuLabel={cpuLabel}
         cpuText={cpuText}
+        faultText={faultText}
         lastError={state.lastError}
         latencyLabel={latencyLabel}
         latencyText={latencyText}
+        memoryText={memoryText}
         nodeCount={state.nodes.length}
+        startupText={startupText}
       />
     </div>
   )
 }
-
-
+
+
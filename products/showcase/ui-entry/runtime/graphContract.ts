@@ -436,7 +436,10 @@ const collectReachableIds = (
 }
 
 export function compileRuntimeGraphPayload(serialized: string): RuntimeGraphPayload {
-  const payload = deserializeGraphPayload(serialized)
+  return compileRuntimeGraph(deserializeGraphPayload(serialized))
+}
+
+export function compileRuntimeGraph(payload: GraphPayloadV1): RuntimeGraphPayload {
   const adjacency = new Map<string, string[]>()
 
   for (const edge of payload.edges) {
@@ -1,6 +1,6 @@
 export const GRAPH_CONTRACT_SCHEMA_VERSION = 1 as const
-export const GRAPH_CONTRACT_MAX_NODES = 16
-export const GRAPH_CONTRACT_MAX_EDGES = 64
+export const GRAPH_CONTRACT_MAX_NODES = 128
+export const GRAPH_CONTRACT_MAX_EDGES = 256
 export const GRAPH_CONTRACT_EVENT_ID = 'moonvst:showcase:graph-payload'
 
 export const GRAPH_CONTRACT_ERRORS = {
@@ -20,55 +20,82 @@ export const GRAPH_EDGE_BANK_OFFSET = GRAPH_NODE_BANK_OFFSET + (GRAPH_CONTRACT_M
 export const GRAPH_REVISION_PARAM_INDEX = GRAPH_EDGE_BANK_OFFSET + (GRAPH_CONTRACT_MAX_EDGES * GRAPH_EDGE_STRIDE)
 export const SHOWCASE_TOTAL_PARAM_COUNT = GRAPH_REVISION_PARAM_INDEX + 1
 
-export function toParamBankWrites(runtime: RuntimeGraphPayload, revision: number): ParamWrite[] {
-  const writes: ParamWrite[] = []
+const GRAPH_BANK_VALUE_COUNT = GRAPH_REVISION_PARAM_INDEX - GRAPH_HEADER_OFFSET
 
-  writes.push({ index: GRAPH_HEADER_OFFSET + 0, value: runtime.schemaVersion })
-  writes.push({ index: GRAPH_HEADER_OFFSET + 1, value: runtime.nodes.length })
-  writes.push({ index: GRAPH_HEADER_OFFSET + 2, value: runtime.edges.length })
-  writes.push({ index: GRAPH_HEADER_OFFSET + 3, value: runtime.hasOutputPath ? 1 : 0 })
+/**
+ * Graph slots of the parameter bank as a flat array. Element i maps to
+ * parameter GRAPH_HEADER_OFFSET + i; the revision slot is not included.
+ */
+export function toParamBankValues(runtime: RuntimeGraphPayload): number[] {
+  const values = new Array<number>(GRAPH_BANK_VALUE_COUNT)
+
+  values[0] = runtime.schemaVersion
+  values[1] = runtime.nodes.length
+  values[2] = runtime.edges.length
+  values[3] = runtime.hasOutputPath ? 1 : 0
 
   for (let i = 0; i < GRAPH_CONTRACT_MAX_NODES; i += 1) {
     const node = runtime.nodes[i]
-    const base = GRAPH_NODE_BANK_OFFSET + (i * GRAPH_NODE_STRIDE)
+    const base = GRAPH_HEADER_SIZE + (i * GRAPH_NODE_STRIDE)
     if (!node) {
-      writes.push({ index: base + 0, value: 0 })
-      writes.push({ index: base + 1, value: 1 })
-      writes.push({ index: base + 2, value: 1 })
-      writes.push({ index: base + 3, value: 0 })
-      writes.push({ index: base + 4, value: 0 })
-      writes.push({ index: base + 5, value: 0 })
-      writes.push({ index: base + 6, value: 0 })
-      writes.push({ index: base + 7, value: 0 })
-      writes.push({ index: base + 8, value: 0 })
-      writes.push({ index: base + 9, value: 0 })
-      writes.push({ index: base + 10, value: 0 })
+      values[base + 0] = 0
+      values[base + 1] = 1
+      values[base + 2] = 1
+      values[base + 3] = 0
+      values[base + 4] = 0
+      values[base + 5] = 0
+      values[base + 6] = 0
+      values[base + 7] = 0
+      values[base + 8] = 0
+      values[base + 9] = 0
+      values[base + 10] = 0
       continue
     }
-    writes.push({ index: base + 0, value: node.effectType })
-    writes.push({ index: base + 1, value: node.bypass ? 1 : 0 })
-    writes.push({ index: base + 2, value: node.p1 })
-    writes.push({ index: base + 3, value: node.p2 })
-    writes.push({ index: base + 4, value: node.p3 })
-    writes.push({ index: base + 5, value: node.p4 })
-    writes.push({ index: base + 6, value: node.p5 })
-    writes.push({ index: base + 7, value: node.p6 })
-    writes.push({ index: base + 8, value: node.p7 })
-    writes.push({ index: base + 9, value: node.p8 })
-    writes.push({ index: base + 10, value: node.p9 })
+    values[base + 0] = node.effectType
+    values[base + 1] = node.bypass ? 1 : 0
+    values[base + 2] = node.p1
+    values[base + 3] = node.p2
+    values[base + 4] = node.p3
+    values[base + 5] = node.p4
+    values[base + 6] = node.p5
+    values[base + 7] = node.p6
+    values[base + 8] = node.p7
+    values[base + 9] = node.p8
+    values[base + 10] = node.p9
   }
 
+  const edgeBase = GRAPH_EDGE_BANK_OFFSET - GRAPH_HEADER_OFFSET
   for (let i = 0; i < GRAPH_CONTRACT_MAX_EDGES; i += 1) {
     const edge = runtime.edges[i]
-    const base = GRAPH_EDGE_BANK_OFFSET + (i * GRAPH_EDGE_STRIDE)
-    writes.push({ index: base + 0, value: edge ? edge.fromIndex : -1 })
-    writes.push({ index: base + 1, value: edge ? edge.toIndex : -1 })
+    const base = edgeBase + (i * GRAPH_EDGE_STRIDE)
+    values[base + 0] = edge ? edge.fromIndex : -1
+    values[base + 1] = edge ? edge.toIndex : -1
   }
 
+  return values
+}
+
+export function toParamBankWrites(runtime: RuntimeGraphPayload, revision: number): ParamWrite[] {
+  const writes = diffParamBankValues(null, toParamBankValues(runtime))
   writes.push({ index: GRAPH_REVISION_PARAM_INDEX, value: revision })
   return writes
 }
 
+/**
+ * Writes needed to move the bank from `previous` to `next`. With no previous
+ * bank every slot is written. The revision slot is left to the caller.
+ */
+export function diffParamBankValues(previous: readonly number[] | null, next: readonly number[]): ParamWrite[] {
+  const writes: ParamWrite[] = []
+  for (let i = 0; i < next.length; i += 1) {
+    if (previous && Object.is(previous[i], next[i])) {
+      continue
+    }
+    writes.push({ index: GRAPH_HEADER_OFFSET + i, value: next[i] })
+  }
+  return writes
+}
+
 export function validateRuntimeGraphSchema(schemaVersion: number): void {
   if (schemaVersion !== GRAPH_CONTRACT_SCHEMA_VERSION) {
     throw new Error('ERR_UNSUPPORTED_SCHEMA_VERSION')
@@ -2,10 +2,15 @@ import { describe, expect, test } from 'vitest'
 import { createDefaultGraphState, graphReducer } from '../state/graphReducer'
 import { compileRuntimeGraphPayload, serializeGraphPayload } from './graphContract'
 import {
+  GRAPH_EDGE_BANK_OFFSET,
+  GRAPH_EDGE_STRIDE,
   GRAPH_HEADER_OFFSET,
+  GRAPH_NODE_STRIDE,
   GRAPH_NODE_BANK_OFFSET,
   GRAPH_REVISION_PARAM_INDEX,
   SHOWCASE_TOTAL_PARAM_COUNT,
+  diffParamBankValues,
+  toParamBankValues,
   toParamBankWrites,
 } from './graphParamBank'
 
@@ -32,4 +37,46 @@ describe('showcase graph param bank', () => {
     expect(byIndex.get(GRAPH_NODE_BANK_OFFSET + 0)).toBe(1)
     expect(byIndex.get(GRAPH_NODE_BANK_OFFSET + 1)).toBe(0)
   })
+
+  test('carries a graph of more than 16 nodes into the bank', () => {
+    let state = createDefaultGraphState({ nodeLimit: 42 })
+    state = graphReducer(state, { type: 'disconnect', fromNodeId: 'input', toNodeId: 'output' })
+    let previous = 'input'
+    for (let i = 0; i < 40; i += 1) {
+      const id = `gain-${String(i).padStart(2, '0')}`
+      state = graphReducer(state, { type: 'addNode', kind: 'gain', x: 100 + i, y: 80, id })
+      state = graphReducer(state, { type: 'connect', fromNodeId: previous, toNodeId: id })
+      previous = id
+    }
+    state = graphReducer(state, { type: 'connect', fromNodeId: previous, toNodeId: 'output' })
+    expect(state.lastError).toBeNull()
+
+    const runtime = compileRuntimeGraphPayload(serializeGraphPayload(state))
+    expect(runtime.nodes).toHaveLength(42)
+    expect(runtime.edges).toHaveLength(41)
+
+    const byIndex = new Map(toParamBankWrites(runtime, 3).map((entry) => [entry.index, entry.value] as const))
+    expect(byIndex.get(GRAPH_HEADER_OFFSET + 1)).toBe(42)
+    expect(byIndex.get(GRAPH_HEADER_OFFSET + 2)).toBe(41)
+    // Slots well past the old 16-node / 64-edge bank are populated.
+    const lastNode = GRAPH_NODE_BANK_OFFSET + (41 * GRAPH_NODE_STRIDE)
+    expect(byIndex.get(lastNode + 0)).toBe(runtime.nodes[41].effectType)
+    expect(byIndex.get(lastNode + 2)).toBe(runtime.nodes[41].p1)
+    const lastEdge = GRAPH_EDGE_BANK_OFFSET + (40 * GRAPH_EDGE_STRIDE)
+    expect(byIndex.get(lastEdge + 0)).toBe(runtime.edges[40].fromIndex)
+    expect(byIndex.get(lastEdge + 1)).toBe(runtime.edges[40].toIndex)
+  })
+
+  test('diffs bank values down to the changed slots', () => {
+    let state = createDefaultGraphState()
+    state = graphReducer(state, { type: 'addNode', kind: 'chorus', x: 250, y: 200, id: 'fx-chorus' })
+    const before = toParamBankValues(compileRuntimeGraphPayload(serializeGraphPayload(state)))
+
+    state = graphReducer(state, { type: 'toggleNodeBypass', nodeId: 'fx-chorus' })
+    const after = toParamBankValues(compileRuntimeGraphPayload(serializeGraphPayload(state)))
+
+    expect(diffParamBankValues(before, before)).toEqual([])
+    expect(diffParamBankValues(before, after)).toEqual([{ index: GRAPH_NODE_BANK_OFFSET + 1, value: 1 }])
+    expect(diffParamBankValues(null, after)).toHaveLength(after.length)
+  })
 })
@@ -1,39 +1,82 @@
 import type { AudioRuntime } from '../../../../packages/ui-core/src/runtime/types'
 import type { GraphState } from '../state/graphTypes'
-import { compileRuntimeGraphPayload, serializeGraphPayload } from './graphContract'
-import { toParamBankWrites, validateRuntimeGraphSchema } from './graphParamBank'
+import { compileRuntimeGraph, normalizeGraphPayload, type GraphPayloadV1 } from './graphContract'
+import {
+  GRAPH_REVISION_PARAM_INDEX,
+  diffParamBankValues,
+  toParamBankValues,
+  validateRuntimeGraphSchema,
+  type ParamWrite,
+} from './graphParamBank'
 
-export function emitGraphPayloadToRuntime(runtime: AudioRuntime | null, payload: string, revision: number): void {
+export function emitGraphWritesToRuntime(runtime: AudioRuntime | null, writes: readonly ParamWrite[]): void {
   if (!runtime) {
     return
   }
-  let graph
-  try {
-    graph = compileRuntimeGraphPayload(payload)
-    validateRuntimeGraphSchema(graph.schemaVersion)
-  } catch {
-    return
-  }
-
-  const writes = toParamBankWrites(graph, revision)
   for (const write of writes) {
     runtime.setParam(write.index, write.value)
   }
 }
 
-export function createGraphRuntimeBridge(emit: (payload: string, revision: number) => void) {
-  let lastPayload: string | null = null
+/**
+ * Keeps the runtime parameter bank in step with the editor graph.
+ *
+ * The reducer replaces `nodes`/`edges` arrays only when they change, so a
+ * state update that touches neither (selection, viewport) costs two identity
+ * checks. Otherwise the graph is compiled straight from the normalized
+ * payload (no JSON round trip) and only the bank slots whose values differ
+ * from the last emitted bank are written, followed by a revision bump.
+ */
+export function createGraphRuntimeBridge(emit: (writes: ParamWrite[], revision: number) => void) {
+  let lastNodes: GraphState['nodes'] | null = null
+  let lastEdges: GraphState['edges'] | null = null
+  let lastPayload: GraphPayloadV1 | null = null
+  let lastSerialized: string | null = null
+  let syncedPayload: GraphPayloadV1 | null = null
+  let lastBank: number[] | null = null
   let revision = 0
 
+  const normalize = (state: GraphState): GraphPayloadV1 => {
+    if (!lastPayload || state.nodes !== lastNodes || state.edges !== lastEdges) {
+      lastPayload = normalizeGraphPayload(state)
+      lastSerialized = null
+      lastNodes = state.nodes
+      lastEdges = state.edges
+    }
+    return lastPayload
+  }
+
   return {
-    sync(state: GraphState): string {
-      const nextPayload = serializeGraphPayload(state)
-      if (nextPayload !== lastPayload) {
-        revision += 1
-        emit(nextPayload, revision)
-        lastPayload = nextPayload
+    /** Emits changed bank slots; returns the number of slot writes emitted. */
+    sync(state: GraphState): number {
+      const payload = normalize(state)
+      if (payload === syncedPayload) {
+        return 0
+      }
+      syncedPayload = payload
+
+      const graph = compileRuntimeGraph(payload)
+      validateRuntimeGraphSchema(graph.schemaVersion)
+      const bank = toParamBankValues(graph)
+      const writes = diffParamBankValues(lastBank, bank)
+      lastBank = bank
+      if (writes.length === 0) {
+        return 0
+      }
+
+      revision += 1
+      writes.push({ index: GRAPH_REVISION_PARAM_INDEX, value: revision })
+      emit(writes, revision)
+      return writes.length
+    },
+
+    /** Serialized graph payload for persistence; cached until the graph changes. */
+    serialize(state: GraphState): string {
+      const payload = normalize(state)
+      if (lastSerialized === null) {
+        lastSerialized = JSON.stringify(payload)
       }
-      return nextPayload
+      return lastSerialized
     },
   }
 }
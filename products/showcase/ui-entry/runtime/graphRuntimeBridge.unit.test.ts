@@ -1,22 +1,68 @@
 import { describe, expect, test, vi } from 'vitest'
 import { createDefaultGraphState, graphReducer } from '../state/graphReducer'
+import { GRAPH_HEADER_OFFSET, GRAPH_REVISION_PARAM_INDEX, SHOWCASE_TOTAL_PARAM_COUNT, type ParamWrite } from './graphParamBank'
 import { createGraphRuntimeBridge } from './graphRuntimeBridge'
 
 describe('showcase graph runtime bridge', () => {
-  test('emits serialized graph payload only when graph changes', () => {
-    const emit = vi.fn<(payload: string, revision: number) => void>()
+  test('emits the full bank once, then only when graph slots change', () => {
+    const emit = vi.fn<(writes: ParamWrite[], revision: number) => void>()
     const bridge = createGraphRuntimeBridge(emit)
 
     let state = createDefaultGraphState()
     bridge.sync(state)
     bridge.sync(state)
     expect(emit).toHaveBeenCalledTimes(1)
+    expect(emit.mock.calls[0]?.[0].length).toBe(SHOWCASE_TOTAL_PARAM_COUNT - GRAPH_HEADER_OFFSET)
     expect(emit.mock.calls[0]?.[1]).toBe(1)
 
     state = graphReducer(state, { type: 'addNode', kind: 'chorus', x: 240, y: 200, id: 'fx-1' })
     bridge.sync(state)
     expect(emit).toHaveBeenCalledTimes(2)
-    expect(() => JSON.parse(emit.mock.calls[1]?.[0] ?? '')).not.toThrow()
     expect(emit.mock.calls[1]?.[1]).toBe(2)
   })
+
+  test('writes only the changed slots for a parameter edit', () => {
+    const emit = vi.fn<(writes: ParamWrite[], revision: number) => void>()
+    const bridge = createGraphRuntimeBridge(emit)
+
+    let state = createDefaultGraphState()
+    state = graphReducer(state, { type: 'addNode', kind: 'chorus', x: 240, y: 200, id: 'fx-1' })
+    bridge.sync(state)
+
+    state = graphReducer(state, { type: 'updateNodeParam', nodeId: 'fx-1', key: 'depth', value: 80 })
+    expect(bridge.sync(state)).toBe(2)
+
+    const writes = emit.mock.calls[1]?.[0] ?? []
+    expect(writes).toHaveLength(2)
+    expect(writes[1]).toEqual({ index: GRAPH_REVISION_PARAM_INDEX, value: 2 })
+  })
+
+  test('skips runtime writes for layout-only and selection changes', () => {
+    const emit = vi.fn<(writes: ParamWrite[], revision: number) => void>()
+    const bridge = createGraphRuntimeBridge(emit)
+
+    let state = createDefaultGraphState()
+    state = graphReducer(state, { type: 'addNode', kind: 'chorus', x: 240, y: 200, id: 'fx-1' })
+    bridge.sync(state)
+
+    state = graphReducer(state, { type: 'moveNode', nodeId: 'fx-1', x: 300, y: 260 })
+    expect(bridge.sync(state)).toBe(0)
+    state = graphReducer(state, { type: 'selectNode', nodeId: 'fx-1' })
+    expect(bridge.sync(state)).toBe(0)
+    expect(emit).toHaveBeenCalledTimes(1)
+  })
+
+  test('serializes the graph payload and reuses it until the graph changes', () => {
+    const bridge = createGraphRuntimeBridge(() => {})
+
+    let state = createDefaultGraphState()
+    const first = bridge.serialize(state)
+    expect(() => JSON.parse(first)).not.toThrow()
+
+    state = graphReducer(state, { type: 'selectNode', nodeId: 'input' })
+    expect(bridge.serialize(state)).toBe(first)
+
+    state = graphReducer(state, { type: 'moveNode', nodeId: 'input', x: 10, y: 10 })
+    expect(bridge.serialize(state)).not.toBe(first)
+  })
 })
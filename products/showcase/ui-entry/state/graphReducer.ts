@@ -7,12 +7,13 @@ import type {
   GraphState,
   NodeId,
 } from './graphTypes'
+import { GRAPH_CONTRACT_MAX_NODES } from '../runtime/graphContractConstants'
 import { getDefaultNodeParams } from './nodeParamSchema'
 
 const INPUT_NODE_ID = 'input'
 const OUTPUT_NODE_ID = 'output'
 const DEFAULT_NODE_LIMIT = 8
-const MAX_NODE_LIMIT = 16
+const MAX_NODE_LIMIT = GRAPH_CONTRACT_MAX_NODES
 
 const FIXED_NODE_IDS = new Set([INPUT_NODE_ID, OUTPUT_NODE_ID])
 
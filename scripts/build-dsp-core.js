@@ -7,6 +7,11 @@ function resolveWasmPath(buildDir, release) {
   return path.join(buildDir, '_build', 'wasm', mode, 'build', 'src', 'src.wasm');
 }
 
+function resolveNativeCPath(buildDir, release) {
+  const mode = release ? 'release' : 'debug';
+  return path.join(buildDir, '_build', 'native', mode, 'build', 'src', 'src.c');
+}
+
 function resolveArchTargetArgs({ platform, arch }) {
   if (arch === 'x64' || arch === 'amd64') {
     return ['--target=x86_64', '--cpu=x86-64'];
@@ -17,6 +22,13 @@ function resolveArchTargetArgs({ platform, arch }) {
   return [];
 }
 
+// The runtime is built with WAMR_DISABLE_HW_BOUND_CHECK, so the AOT image must
+// check memory and native stack bounds itself. --enable-multi-thread makes
+// wamrc emit the suspend-flag checks at function entries and loop heads that
+// let the plugin's watchdog terminate a runaway block; without them
+// wasm_runtime_terminate never reaches AOT code.
+const WAMRC_CHECK_ARGS = ['--bounds-checks=1', '--stack-bounds-checks=1', '--enable-multi-thread'];
+
 function resolveSizeLevel(arch) {
   if (arch === 'arm64' || arch === 'aarch64') {
     // WAMR/LLVM rejects the medium code model on AArch64.
@@ -51,23 +63,33 @@ function createBuildPlan({
   arch = process.arch,
   env = process.env,
   release = false,
+  native = false,
 }) {
   const buildDir = env.MOONVST_DSP_BUILD_DIR
     ? path.resolve(rootDir, env.MOONVST_DSP_BUILD_DIR)
     : path.join(rootDir, 'build', 'dsp-active');
   const wasmPath = resolveWasmPath(buildDir, release);
+  const target = native ? 'native' : 'wasm';
 
   return {
     rootDir,
     buildDir,
     wasmPath,
-    moonArgs: release ? ['build', '--target', 'wasm', '--release'] : ['build', '--target', 'wasm'],
+    native,
+    moonArgs: release ? ['build', '--target', target, '--release'] : ['build', '--target', target],
+    nativeCPath: resolveNativeCPath(buildDir, release),
+    nativeDestDir: path.join(rootDir, 'build', 'dsp-native'),
+    nativeDestPath: path.join(rootDir, 'build', 'dsp-native', 'moonvst_dsp.c'),
+    nativeStubPath: path.join(buildDir, 'src', 'utils', 'native_memory.c'),
+    nativeStubDestPath: path.join(rootDir, 'build', 'dsp-native', 'native_memory.c'),
     wasmDestDir: path.join(rootDir, 'packages', 'ui-core', 'public', 'wasm'),
     wasmDestPath: path.join(rootDir, 'packages', 'ui-core', 'public', 'wasm', 'moonvst_dsp.wasm'),
     aotDestDir: path.join(rootDir, 'plugin', 'resources'),
     aotDestPath: path.join(rootDir, 'plugin', 'resources', 'moonvst_dsp.aot'),
+    pluginWasmDestPath: path.join(rootDir, 'plugin', 'resources', 'moonvst_dsp.wasm'),
     wamrcSizeLevel: resolveSizeLevel(arch),
     wamrcTargetArgs: resolveArchTargetArgs({ platform, arch }),
+    wamrcCheckArgs: WAMRC_CHECK_ARGS,
     platform,
   };
 }
@@ -84,7 +106,8 @@ function runBuildDspCore({
   copy = copyFileSync,
 } = {}) {
   const release = args.includes('--release');
-  const plan = createBuildPlan({ rootDir, platform, arch, env, release });
+  const native = args.includes('--native');
+  const plan = createBuildPlan({ rootDir, platform, arch, env, release, native });
 
   console.log('=== Building MoonBit DSP ===');
   exec('moon', plan.moonArgs, {
@@ -92,6 +115,20 @@ function runBuildDspCore({
     stdio: 'inherit',
   });
 
+  if (plan.native) {
+    if (!exists(plan.nativeCPath)) {
+      throw new Error(`C backend output not found at ${plan.nativeCPath}`);
+    }
+
+    console.log('=== Copying C backend sources for the native plugin build ===');
+    mkdir(plan.nativeDestDir, { recursive: true });
+    copy(plan.nativeCPath, plan.nativeDestPath);
+    copy(plan.nativeStubPath, plan.nativeStubDestPath);
+
+    console.log('=== DSP build complete ===');
+    return plan;
+  }
+
   if (!exists(plan.wasmPath)) {
     throw new Error(`WASM output not found at ${plan.wasmPath}`);
   }
@@ -103,9 +140,19 @@ function runBuildDspCore({
   console.log('=== AOT Compiling ===');
   const wamrcPath = resolveWamrcPath({ rootDir, platform, exists });
   mkdir(plan.aotDestDir, { recursive: true });
+  // Bytecode ships next to the AOT image so WasmDSP can fall back to JIT/interpreter.
+  copy(plan.wasmPath, plan.pluginWasmDestPath);
   exec(
     wamrcPath,
-    ['--opt-level=3', `--size-level=${plan.wamrcSizeLevel}`, ...plan.wamrcTargetArgs, '-o', plan.aotDestPath, plan.wasmPath],
+    [
+      '--opt-level=3',
+      `--size-level=${plan.wamrcSizeLevel}`,
+      ...plan.wamrcTargetArgs,
+      ...plan.wamrcCheckArgs,
+      '-o',
+      plan.aotDestPath,
+      plan.wasmPath,
+    ],
     { stdio: 'inherit' },
   );
 
@@ -119,6 +166,7 @@ if (require.main === module) {
 
 module.exports = {
   createBuildPlan,
+  resolveNativeCPath,
   resolveWamrcPath,
   resolveWasmPath,
   resolveSizeLevel,
@@ -59,3 +59,87 @@ test('createBuildPlan uses darwin arm64 triple for wamrc target', () => {
   assert.deepEqual(plan.wamrcTargetArgs, ['--target=aarch64-apple-darwin']);
   assert.equal(plan.wamrcSizeLevel, '3');
 });
+
+test('createBuildPlan targets the C backend with --native', () => {
+  const { createBuildPlan } = require('./build-dsp-core');
+  const rootDir = path.join(path.sep, 'repo');
+  const plan = createBuildPlan({
+    rootDir,
+    platform: 'linux',
+    arch: 'x64',
+    env: {},
+    release: true,
+    native: true,
+  });
+
+  assert.deepEqual(plan.moonArgs, ['build', '--target', 'native', '--release']);
+  assert.equal(plan.nativeCPath, path.join(rootDir, 'build', 'dsp-active', '_build', 'native', 'release', 'build', 'src', 'src.c'));
+  assert.equal(plan.nativeDestPath, path.join(rootDir, 'build', 'dsp-native', 'moonvst_dsp.c'));
+});
+
+test('runBuildDspCore --native copies C sources and skips the AOT step', () => {
+  const { runBuildDspCore } = require('./build-dsp-core');
+  const rootDir = path.join(path.sep, 'repo');
+  const execCalls = [];
+  const copies = [];
+  runBuildDspCore({
+    rootDir,
+    platform: 'linux',
+    arch: 'x64',
+    env: {},
+    args: ['--native'],
+    exec: (cmd, args) => execCalls.push([cmd, ...args]),
+    exists: () => true,
+    mkdir: () => {},
+    copy: (from, to) => copies.push([from, to]),
+  });
+
+  assert.deepEqual(execCalls, [['moon', 'build', '--target', 'native']]);
+  assert.deepEqual(copies.map(([, to]) => path.basename(to)), ['moonvst_dsp.c', 'native_memory.c']);
+});
+
+test('runBuildDspCore embeds the wasm bytecode next to the AOT image', () => {
+  const { runBuildDspCore } = require('./build-dsp-core');
+  const rootDir = path.join(path.sep, 'repo');
+  const execCalls = [];
+  const copies = [];
+  const plan = runBuildDspCore({
+    rootDir,
+    platform: 'linux',
+    arch: 'x64',
+    env: {},
+    args: [],
+    exec: (cmd, args) => execCalls.push([cmd, ...args]),
+    exists: () => true,
+    mkdir: () => {},
+    copy: (from, to) => copies.push([from, to]),
+  });
+
+  assert.deepEqual(copies, [
+    [plan.wasmPath, plan.wasmDestPath],
+    [plan.wasmPath, path.join(rootDir, 'plugin', 'resources', 'moonvst_dsp.wasm')],
+  ]);
+  assert.equal(execCalls[1][execCalls[1].indexOf('-o') + 1], plan.aotDestPath);
+});
+
+test('runBuildDspCore compiles bounds and termination checks into the AOT image', () => {
+  const { runBuildDspCore } = require('./build-dsp-core');
+  const execCalls = [];
+  runBuildDspCore({
+    rootDir: path.join(path.sep, 'repo'),
+    platform: 'darwin',
+    arch: 'arm64',
+    env: {},
+    args: ['--release'],
+    exec: (cmd, args) => execCalls.push([cmd, ...args]),
+    exists: () => true,
+    mkdir: () => {},
+    copy: () => {},
+  });
+
+  const wamrcArgs = execCalls[1];
+  assert.ok(wamrcArgs.includes('--bounds-checks=1'));
+  assert.ok(wamrcArgs.includes('--stack-bounds-checks=1'));
+  assert.ok(wamrcArgs.includes('--enable-multi-thread'));
+  assert.ok(wamrcArgs.indexOf('--enable-multi-thread') < wamrcArgs.indexOf('-o'));
+});
@@ -1,14 +1,19 @@
 const { execFileSync } = require('child_process');
 const path = require('path');
+const { runGenMemoryLayout } = require('./gen-memory-layout');
 const { selectProduct } = require('./select-product');
 
 function runBuildDspProduct({
   product = process.env.MOONVST_PRODUCT || 'template',
   root = path.resolve(__dirname, '..'),
   args = process.argv.slice(2),
+  genMemoryLayout: genLayout = runGenMemoryLayout,
   selectProduct: select = selectProduct,
   execFileSync: execFile = execFileSync,
 } = {}) {
+  // The layout is sized per product, so regenerate it before the core is
+  // copied into build/dsp-active.
+  genLayout({ rootDir: root, product });
   select(product);
   execFile(process.execPath, ['scripts/build-dsp-core.js', ...args], {
     cwd: root,
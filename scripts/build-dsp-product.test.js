@@ -6,7 +6,7 @@ test('build-dsp-product exports runBuildDspProduct', () => {
   assert.equal(typeof mod.runBuildDspProduct, 'function');
 });
 
-test('runBuildDspProduct selects product and invokes node build-dsp-core.js', () => {
+test('runBuildDspProduct sizes the layout, selects product and invokes node build-dsp-core.js', () => {
   const calls = [];
   const { runBuildDspProduct } = require('./build-dsp-product');
 
@@ -14,6 +14,9 @@ test('runBuildDspProduct selects product and invokes node build-dsp-core.js', ()
     product: 'showcase',
     root: '/repo',
     args: ['--release'],
+    genMemoryLayout: (options) => {
+      calls.push(['layout', options]);
+    },
     selectProduct: (value) => {
       calls.push(['select', value]);
     },
@@ -22,10 +25,11 @@ test('runBuildDspProduct selects product and invokes node build-dsp-core.js', ()
     },
   });
 
-  assert.deepEqual(calls[0], ['select', 'showcase']);
-  assert.equal(calls[1][0], 'exec');
-  assert.equal(calls[1][1], process.execPath);
-  assert.deepEqual(calls[1][2], ['scripts/build-dsp-core.js', '--release']);
-  assert.equal(calls[1][3].cwd, '/repo');
-  assert.equal(calls[1][3].stdio, 'inherit');
+  assert.deepEqual(calls[0], ['layout', { rootDir: '/repo', product: 'showcase' }]);
+  assert.deepEqual(calls[1], ['select', 'showcase']);
+  assert.equal(calls[2][0], 'exec');
+  assert.equal(calls[2][1], process.execPath);
+  assert.deepEqual(calls[2][2], ['scripts/build-dsp-core.js', '--release']);
+  assert.equal(calls[2][3].cwd, '/repo');
+  assert.equal(calls[2][3].stdio, 'inherit');
 });
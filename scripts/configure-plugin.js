@@ -6,6 +6,7 @@ const VALID_PRODUCT = /^[a-z0-9][a-z0-9-]*$/;
 const args = process.argv.slice(2);
 const product = process.env.MOONVST_PRODUCT || 'template';
 const enableUnity = args.includes('--unity');
+const enableNativeDsp = args.includes('--native');
 
 if (!VALID_PRODUCT.test(product)) {
   throw new Error(`invalid product name: ${product}`);
@@ -23,6 +24,7 @@ const cmakeArgs = [
   '-DCMAKE_BUILD_TYPE=Release',
   `-DMOONVST_PRODUCT=${product}`,
   `-DMOONVST_ENABLE_UNITY=${enableUnity ? 'ON' : 'OFF'}`,
+  `-DMOONVST_NATIVE_DSP=${enableNativeDsp ? 'ON' : 'OFF'}`,
 ];
 
 execFileSync('cmake', cmakeArgs, {
@@ -5,7 +5,98 @@ function formatHex(value) {
   return `0x${value.toString(16).toUpperCase()}`;
 }
 
-function parseContract(jsonText, sourcePath) {
+const WASM_PAGE_BYTES = 0x10000;
+const VALID_PRODUCT = /^[a-z0-9][a-z0-9-]*$/;
+
+// Regions every DSP build relies on. Channel regions hold max_channels planar
+// channels of max_buffer_samples each (fewer when the product caps its buses
+// with audio.maxChannels); the others declare their footprint.
+const REQUIRED_REGIONS = ['input', 'output', 'string_buf', 'chorus_mem', 'reverb_mem'];
+
+function alignUp(value, alignment) {
+  return Math.ceil(value / alignment) * alignment;
+}
+
+// Places the regions in declaration order from reserved_low_bytes upwards,
+// each on an `alignment` boundary. A region may pin itself with `offset`; it
+// must then be aligned and must not overlap anything placed before it.
+function allocateRegions(regions, { alignment, reservedLowBytes, channelBlockBytes }) {
+  if (!Array.isArray(regions)) {
+    throw new Error('contracts/memory-layout.json must define regions as an array');
+  }
+
+  const placed = new Map();
+  let cursor = reservedLowBytes;
+  let previous = null;
+  for (const region of regions) {
+    const name = region && region.name;
+    if (!REQUIRED_REGIONS.includes(name)) {
+      throw new Error(`contracts/memory-layout.json has unknown region ${JSON.stringify(name)}`);
+    }
+    if (placed.has(name)) {
+      throw new Error(`contracts/memory-layout.json declares region ${name} twice`);
+    }
+
+    const isChannelBlock = name === 'input' || name === 'output';
+    const bytes = isChannelBlock ? channelBlockBytes : region.bytes;
+    if (!Number.isInteger(bytes) || bytes <= 0) {
+      throw new Error(`contracts/memory-layout.json region ${name} must declare bytes as a positive integer`);
+    }
+
+    let offset = alignUp(cursor, alignment);
+    if (region.offset !== undefined) {
+      if (!Number.isInteger(region.offset) || region.offset % alignment !== 0) {
+        throw new Error(`contracts/memory-layout.json region ${name} offset must be a multiple of ${alignment}`);
+      }
+      if (region.offset < cursor) {
+        throw new Error(
+          `contracts/memory-layout.json regions ${previous || 'reserved_low_bytes'} and ${name} overlap`,
+        );
+      }
+      offset = region.offset;
+    }
+
+    placed.set(name, { offset, bytes });
+    cursor = offset + bytes;
+    previous = name;
+  }
+
+  for (const name of REQUIRED_REGIONS) {
+    if (!placed.has(name)) {
+      throw new Error(`contracts/memory-layout.json is missing region ${name}`);
+    }
+  }
+  return { placed, end: cursor };
+}
+
+// Reads audio.maxChannels from products/<product>/product.config.json, or
+// returns undefined when the product leaves its channel count open.
+function readProductMaxChannels(rootDir, product, io) {
+  if (!VALID_PRODUCT.test(product)) {
+    throw new Error(`invalid product name: ${product}`);
+  }
+  const configPath = path.join(rootDir, 'products', product, 'product.config.json');
+  if (!io.existsSync(configPath)) {
+    return undefined;
+  }
+
+  let config;
+  try {
+    config = JSON.parse(io.readFileSync(configPath, 'utf8').replace(/^\uFEFF/, ''));
+  } catch (error) {
+    throw new Error(`Failed to parse JSON: ${configPath}\n${error.message}`);
+  }
+  const maxChannels = config.audio && config.audio.maxChannels;
+  if (maxChannels === undefined) {
+    return undefined;
+  }
+  if (!Number.isInteger(maxChannels) || maxChannels <= 0) {
+    throw new Error(`${configPath}: audio.maxChannels must be a positive integer`);
+  }
+  return maxChannels;
+}
+
+function parseContract(jsonText, sourcePath, { productMaxChannels } = {}) {
   let parsed;
   try {
     parsed = JSON.parse(jsonText);
@@ -15,47 +106,84 @@ function parseContract(jsonText, sourcePath) {
 
   const bytesPerSample = Number(parsed.bytes_per_sample);
   const maxBufferSamples = Number(parsed.max_buffer_samples);
-  const offsets = parsed.offsets || {};
-
-  const requiredOffsetKeys = [
-    'input_left',
-    'input_right',
-    'output_left',
-    'output_right',
-    'string_buf',
-    'reverb_mem_base_ptr',
-    'chorus_mem_base_ptr',
-  ];
+  const contractMaxChannels = Number(parsed.max_channels);
+  const alignment = Number(parsed.alignment);
+  const reservedLowBytes = Number(parsed.reserved_low_bytes);
 
-  for (const key of requiredOffsetKeys) {
-    if (!Number.isInteger(offsets[key])) {
-      throw new Error(`contracts/memory-layout.json is missing integer offsets.${key}`);
-    }
-  }
   if (!Number.isInteger(bytesPerSample) || bytesPerSample <= 0) {
     throw new Error('contracts/memory-layout.json must define bytes_per_sample as a positive integer');
   }
   if (!Number.isInteger(maxBufferSamples) || maxBufferSamples <= 0) {
     throw new Error('contracts/memory-layout.json must define max_buffer_samples as a positive integer');
   }
+  if (!Number.isInteger(contractMaxChannels) || contractMaxChannels < 2) {
+    throw new Error('contracts/memory-layout.json must define max_channels as an integer of at least 2');
+  }
+  if (!Number.isInteger(alignment) || alignment < bytesPerSample || (alignment & (alignment - 1)) !== 0) {
+    throw new Error('contracts/memory-layout.json must define alignment as a power of two of at least bytes_per_sample');
+  }
+  if (!Number.isInteger(reservedLowBytes) || reservedLowBytes < 0) {
+    throw new Error('contracts/memory-layout.json must define reserved_low_bytes as a non-negative integer');
+  }
+
+  // A product that accepts fewer channels only reserves room for those. The
+  // stereo pair stays addressable, so mono products still get two channels.
+  const maxChannels = productMaxChannels === undefined
+    ? contractMaxChannels
+    : Math.min(contractMaxChannels, Math.max(2, productMaxChannels));
 
+  // Planar I/O: channel c of a block lives at base + c * channelStride.
+  const channelStride = bytesPerSample * maxBufferSamples;
+  if (channelStride % alignment !== 0) {
+    throw new Error('contracts/memory-layout.json max_buffer_samples * bytes_per_sample must be a multiple of alignment');
+  }
+  const { placed, end } = allocateRegions(parsed.regions, {
+    alignment,
+    reservedLowBytes,
+    channelBlockBytes: channelStride * maxChannels,
+  });
+
+  const input = placed.get('input');
+  const output = placed.get('output');
+  const stringBuf = placed.get('string_buf');
+  const chorusMem = placed.get('chorus_mem');
+  const reverbMem = placed.get('reverb_mem');
   return {
     bytesPerSample,
     maxBufferSamples,
+    maxChannels,
+    channelStride,
+    // The MoonBit heap starts on the first whole page after the regions.
+    heapStartAddress: alignUp(end, WASM_PAGE_BYTES),
     offsets: {
-      inputLeft: offsets.input_left,
-      inputRight: offsets.input_right,
-      outputLeft: offsets.output_left,
-      outputRight: offsets.output_right,
-      stringBuf: offsets.string_buf,
-      reverbMemBasePtr: offsets.reverb_mem_base_ptr,
-      chorusMemBasePtr: offsets.chorus_mem_base_ptr,
+      inputBase: input.offset,
+      outputBase: output.offset,
+      inputLeft: input.offset,
+      inputRight: input.offset + channelStride,
+      outputLeft: output.offset,
+      outputRight: output.offset + channelStride,
+      stringBuf: stringBuf.offset,
+      reverbMemBasePtr: reverbMem.offset,
+      chorusMemBasePtr: chorusMem.offset,
+    },
+    sizes: {
+      stringBuf: stringBuf.bytes,
+      reverbMem: reverbMem.bytes,
+      chorusMem: chorusMem.bytes,
     },
   };
 }
 
 function renderMoonBitOffsets(layout) {
   return [
+    `pub let max_channels : Int = ${layout.maxChannels}`,
+    '',
+    `pub let channel_stride_bytes : Int = ${formatHex(layout.channelStride)}`,
+    '',
+    `pub let input_base_offset : Int = ${formatHex(layout.offsets.inputBase)}`,
+    '',
+    `pub let output_base_offset : Int = ${formatHex(layout.offsets.outputBase)}`,
+    '',
     `pub let input_left_offset : Int = ${formatHex(layout.offsets.inputLeft)}`,
     '',
     `pub let input_right_offset : Int = ${formatHex(layout.offsets.inputRight)}`,
@@ -66,20 +194,26 @@ function renderMoonBitOffsets(layout) {
     '',
     `pub let string_buf_offset : Int = ${formatHex(layout.offsets.stringBuf)}`,
     '',
+    `pub let string_buf_bytes : Int = ${layout.sizes.stringBuf}`,
+    '',
     `pub let reverb_mem_base_ptr : Int = ${formatHex(layout.offsets.reverbMemBasePtr)}`,
     '',
+    `pub let reverb_mem_bytes : Int = ${layout.sizes.reverbMem}`,
+    '',
     `pub let chorus_mem_base_ptr : Int = ${formatHex(layout.offsets.chorusMemBasePtr)}`,
     '',
+    `pub let chorus_mem_bytes : Int = ${layout.sizes.chorusMem}`,
+    '',
     '',
   ].join('\n');
 }
 
 function renderWorkletOffsets(layout) {
   return [
-    `this.INPUT_LEFT_OFFSET = ${formatHex(layout.offsets.inputLeft)}`,
-    `this.INPUT_RIGHT_OFFSET = ${formatHex(layout.offsets.inputRight)}`,
-    `this.OUTPUT_LEFT_OFFSET = ${formatHex(layout.offsets.outputLeft)}`,
-    `this.OUTPUT_RIGHT_OFFSET = ${formatHex(layout.offsets.outputRight)}`,
+    '// AUTO-GENERATED by scripts/gen-memory-layout.js (next 3 lines). DO NOT EDIT.',
+    `this.CHANNEL_STRIDE_BYTES = ${formatHex(layout.channelStride)}`,
+    `this.INPUT_BASE_OFFSET = ${formatHex(layout.offsets.inputBase)}`,
+    `this.OUTPUT_BASE_OFFSET = ${formatHex(layout.offsets.outputBase)}`,
   ].join('\n');
 }
 
@@ -90,14 +224,19 @@ function renderCppHeader(layout) {
     '',
     'namespace moonvst::memory_layout {',
     `static constexpr int BYTES_PER_SAMPLE = ${layout.bytesPerSample};`,
-    `static constexpr int INPUT_LEFT_OFFSET = ${formatHex(layout.offsets.inputLeft)};`,
-    `static constexpr int INPUT_RIGHT_OFFSET = ${formatHex(layout.offsets.inputRight)};`,
-    `static constexpr int OUTPUT_LEFT_OFFSET = ${formatHex(layout.offsets.outputLeft)};`,
-    `static constexpr int OUTPUT_RIGHT_OFFSET = ${formatHex(layout.offsets.outputRight)};`,
+    `static constexpr int MAX_CHANNELS = ${layout.maxChannels};`,
+    `static constexpr int CHANNEL_STRIDE_BYTES = ${formatHex(layout.channelStride)};`,
+    `static constexpr int INPUT_BASE_OFFSET = ${formatHex(layout.offsets.inputBase)};`,
+    `static constexpr int OUTPUT_BASE_OFFSET = ${formatHex(layout.offsets.outputBase)};`,
     `static constexpr int STRING_BUF_OFFSET = ${formatHex(layout.offsets.stringBuf)};`,
+    `static constexpr int STRING_BUF_BYTES = ${layout.sizes.stringBuf};`,
     `static constexpr int REVERB_MEM_BASE_PTR = ${formatHex(layout.offsets.reverbMemBasePtr)};`,
     `static constexpr int CHORUS_MEM_BASE_PTR = ${formatHex(layout.offsets.chorusMemBasePtr)};`,
     `static constexpr int MAX_BUFFER_SAMPLES = ${layout.maxBufferSamples};`,
+    `static constexpr int HEAP_START_ADDRESS = ${formatHex(layout.heapStartAddress)};`,
+    '',
+    'constexpr int inputChannelOffset (int channel) { return INPUT_BASE_OFFSET + channel * CHANNEL_STRIDE_BYTES; }',
+    'constexpr int outputChannelOffset (int channel) { return OUTPUT_BASE_OFFSET + channel * CHANNEL_STRIDE_BYTES; }',
     '}',
     '',
   ].join('\n');
@@ -111,7 +250,7 @@ function replaceOrThrow(content, pattern, replacement, filePath) {
 }
 
 function createUpdatedConstantsMbt(content, layout, filePath) {
-  const blockStart = content.indexOf('pub let input_left_offset');
+  const blockStart = content.indexOf('pub let max_channels');
   const blockEnd = content.indexOf('pub fn set_sample_rate(');
   if (blockStart === -1 || blockEnd === -1 || blockStart >= blockEnd) {
     throw new Error(`Failed to locate generated block in ${filePath}`);
@@ -122,12 +261,30 @@ function createUpdatedConstantsMbt(content, layout, filePath) {
 function createUpdatedWorklet(content, layout, filePath) {
   return replaceOrThrow(
     content,
-    /^\s*this\.INPUT_LEFT_OFFSET[^\r\n]*\r?\n\s*this\.INPUT_RIGHT_OFFSET[^\r\n]*\r?\n\s*this\.OUTPUT_LEFT_OFFSET[^\r\n]*\r?\n\s*this\.OUTPUT_RIGHT_OFFSET[^\r\n]*/m,
+    /^[ \t]*(?:\/\/ AUTO-GENERATED[^\r\n]*\r?\n[ \t]*)?this\.CHANNEL_STRIDE_BYTES[^\r\n]*\r?\n\s*this\.INPUT_BASE_OFFSET[^\r\n]*\r?\n\s*this\.OUTPUT_BASE_OFFSET[^\r\n]*/m,
     `    ${renderWorkletOffsets(layout).replace(/\n/g, '\n    ')}`,
     filePath,
   );
 }
 
+function createUpdatedMoonPkg(content, layout, filePath) {
+  return replaceOrThrow(
+    content,
+    /("heap-start-address"\s*:\s*)\d+/,
+    `$1${layout.heapStartAddress}`,
+    filePath,
+  );
+}
+
+function createUpdatedNativeMemory(content, layout, filePath) {
+  return replaceOrThrow(
+    content,
+    /(#define MOONVST_NATIVE_ARENA_BYTES )\d+/,
+    `$1${layout.heapStartAddress}`,
+    filePath,
+  );
+}
+
 function generateArtifacts(layout) {
   return {
     cppHeader: renderCppHeader(layout),
@@ -138,6 +295,7 @@ function generateArtifacts(layout) {
 
 function runGenMemoryLayout({
   rootDir = path.resolve(__dirname, '..'),
+  product = 'template',
   check = false,
   io = {
     readFileSync: fs.readFileSync,
@@ -150,22 +308,32 @@ function runGenMemoryLayout({
   const constantsPath = path.join(rootDir, 'packages', 'dsp-core', 'src', 'utils', 'constants.mbt');
   const workletPath = path.join(rootDir, 'packages', 'ui-core', 'public', 'worklet', 'processor.js');
   const headerPath = path.join(rootDir, 'plugin', 'include', 'moonvst', 'memory_layout_gen.h');
+  const moonPkgPath = path.join(rootDir, 'packages', 'dsp-core', 'src', 'moon.pkg.json');
+  const nativeMemoryPath = path.join(rootDir, 'packages', 'dsp-core', 'src', 'utils', 'native_memory.c');
 
-  const contract = parseContract(io.readFileSync(contractPath, 'utf8'), contractPath);
+  const contract = parseContract(io.readFileSync(contractPath, 'utf8'), contractPath, {
+    productMaxChannels: readProductMaxChannels(rootDir, product, io),
+  });
   const artifacts = generateArtifacts(contract);
 
   const currentConstants = io.readFileSync(constantsPath, 'utf8');
   const currentWorklet = io.readFileSync(workletPath, 'utf8');
   const currentHeader = io.existsSync(headerPath) ? io.readFileSync(headerPath, 'utf8') : '';
+  const currentMoonPkg = io.readFileSync(moonPkgPath, 'utf8');
+  const currentNativeMemory = io.readFileSync(nativeMemoryPath, 'utf8');
 
   const nextConstants = createUpdatedConstantsMbt(currentConstants, contract, constantsPath);
   const nextWorklet = createUpdatedWorklet(currentWorklet, contract, workletPath);
   const nextHeader = artifacts.cppHeader;
+  const nextMoonPkg = createUpdatedMoonPkg(currentMoonPkg, contract, moonPkgPath);
+  const nextNativeMemory = createUpdatedNativeMemory(currentNativeMemory, contract, nativeMemoryPath);
 
   const updates = [
     { filePath: constantsPath, current: currentConstants, next: nextConstants },
     { filePath: workletPath, current: currentWorklet, next: nextWorklet },
     { filePath: headerPath, current: currentHeader, next: nextHeader },
+    { filePath: moonPkgPath, current: currentMoonPkg, next: nextMoonPkg },
+    { filePath: nativeMemoryPath, current: currentNativeMemory, next: nextNativeMemory },
   ];
 
   const staleFiles = updates.filter((entry) => entry.current !== entry.next).map((entry) => entry.filePath);
@@ -186,13 +354,28 @@ function runGenMemoryLayout({
     io.mkdirSync(path.dirname(headerPath), { recursive: true });
     io.writeFileSync(headerPath, nextHeader);
   }
+  if (nextMoonPkg !== currentMoonPkg) {
+    io.writeFileSync(moonPkgPath, nextMoonPkg);
+  }
+  if (nextNativeMemory !== currentNativeMemory) {
+    io.writeFileSync(nativeMemoryPath, nextNativeMemory);
+  }
 
   return { changedFiles: staleFiles, staleFiles };
 }
 
+function parseProductFromArgs(argv) {
+  const productFlagIndex = argv.indexOf('--product');
+  if (productFlagIndex !== -1 && argv[productFlagIndex + 1]) {
+    return argv[productFlagIndex + 1];
+  }
+  return process.env.MOONVST_PRODUCT || 'template';
+}
+
 function main() {
-  const check = process.argv.includes('--check');
-  runGenMemoryLayout({ check });
+  const argv = process.argv.slice(2);
+  const check = argv.includes('--check');
+  runGenMemoryLayout({ product: parseProductFromArgs(argv), check });
 }
 
 if (require.main === module) {
@@ -9,6 +9,53 @@ const {
   runGenMemoryLayout,
 } = require('./gen-memory-layout');
 
+function contract(overrides = {}) {
+  return {
+    bytes_per_sample: 4,
+    max_buffer_samples: 16384,
+    max_channels: 2,
+    alignment: 64,
+    reserved_low_bytes: 0x10000,
+    regions: [
+      { name: 'input' },
+      { name: 'output' },
+      { name: 'string_buf', bytes: 256 },
+      { name: 'chorus_mem', bytes: 100 },
+      { name: 'reverb_mem', bytes: 0x1000 },
+    ],
+    ...overrides,
+  };
+}
+
+function writeDspPackageFixtures(tmpRoot) {
+  const srcDir = path.join(tmpRoot, 'packages', 'dsp-core', 'src');
+  fs.mkdirSync(path.join(srcDir, 'utils'), { recursive: true });
+  fs.writeFileSync(path.join(srcDir, 'moon.pkg.json'), [
+    '{',
+    '  "link": {',
+    '    "wasm": {',
+    '      "heap-start-address": 1',
+    '    }',
+    '  }',
+    '}',
+    '',
+  ].join('\r\n'));
+  fs.writeFileSync(path.join(srcDir, 'utils', 'native_memory.c'), [
+    '#ifndef MOONVST_NATIVE_ARENA_BYTES',
+    '#define MOONVST_NATIVE_ARENA_BYTES 1',
+    '#endif',
+    '',
+  ].join('\n'));
+}
+
+function writeContractOnly(prefix, json) {
+  const tmpRoot = fs.mkdtempSync(path.join(os.tmpdir(), prefix));
+  const contractsDir = path.join(tmpRoot, 'contracts');
+  fs.mkdirSync(contractsDir, { recursive: true });
+  fs.writeFileSync(path.join(contractsDir, 'memory-layout.json'), JSON.stringify(json, null, 2));
+  return tmpRoot;
+}
+
 test('gen-memory-layout exports required functions', () => {
   assert.equal(typeof generateArtifacts, 'function');
   assert.equal(typeof runGenMemoryLayout, 'function');
@@ -26,23 +73,12 @@ test('runGenMemoryLayout updates targets from contract json', () => {
   fs.mkdirSync(workletDir, { recursive: true });
   fs.mkdirSync(pluginIncludeDir, { recursive: true });
 
-  fs.writeFileSync(path.join(contractsDir, 'memory-layout.json'), JSON.stringify({
-    bytes_per_sample: 4,
-    max_buffer_samples: 16384,
-    offsets: {
-      input_left: 0x10000,
-      input_right: 0x20000,
-      output_left: 0x30000,
-      output_right: 0x40000,
-      string_buf: 0x50000,
-      reverb_mem_base_ptr: 0x60000,
-      chorus_mem_base_ptr: 0x78000,
-    },
-  }, null, 2));
+  fs.writeFileSync(path.join(contractsDir, 'memory-layout.json'), JSON.stringify(contract(), null, 2));
 
   fs.writeFileSync(path.join(dspUtilsDir, 'constants.mbt'), [
     'let sample_rate_hz_box : Array[Float] = [48000.0]',
     '',
+    'pub let max_channels : Int = 0',
     'pub let input_left_offset : Int = 1',
     'pub let input_right_offset : Int = 2',
     'pub let output_left_offset : Int = 3',
@@ -58,26 +94,55 @@ test('runGenMemoryLayout updates targets from contract json', () => {
   fs.writeFileSync(path.join(workletDir, 'processor.js'), [
     'class MoonVSTProcessor extends AudioWorkletProcessor {',
     '  constructor() {',
-    '    this.INPUT_LEFT_OFFSET = 1',
-    '    this.INPUT_RIGHT_OFFSET = 2',
-    '    this.OUTPUT_LEFT_OFFSET = 3',
-    '    this.OUTPUT_RIGHT_OFFSET = 4',
+    '    this.CHANNEL_STRIDE_BYTES = 1',
+    '    this.INPUT_BASE_OFFSET = 2',
+    '    this.OUTPUT_BASE_OFFSET = 3',
     '  }',
     '}',
     '',
   ].join('\n'));
 
+  writeDspPackageFixtures(tmpRoot);
+
   runGenMemoryLayout({ rootDir: tmpRoot, check: false });
 
   const mbt = fs.readFileSync(path.join(dspUtilsDir, 'constants.mbt'), 'utf8');
   const worklet = fs.readFileSync(path.join(workletDir, 'processor.js'), 'utf8');
   const cpp = fs.readFileSync(path.join(pluginIncludeDir, 'memory_layout_gen.h'), 'utf8');
+  const moonPkg = fs.readFileSync(path.join(tmpRoot, 'packages', 'dsp-core', 'src', 'moon.pkg.json'), 'utf8');
+  const nativeMemory = fs.readFileSync(
+    path.join(tmpRoot, 'packages', 'dsp-core', 'src', 'utils', 'native_memory.c'),
+    'utf8',
+  );
 
-  assert.match(mbt, /pub let input_left_offset : Int = 0x10000/);
-  assert.match(mbt, /pub let reverb_mem_base_ptr : Int = 0x60000/);
-  assert.match(worklet, /this\.OUTPUT_RIGHT_OFFSET = 0x40000/);
-  assert.match(cpp, /static constexpr int INPUT_LEFT_OFFSET = 0x10000;/);
+  assert.match(mbt, /pub let max_channels : Int = 2/);
+  assert.match(mbt, /pub let input_base_offset : Int = 0x10000/);
+  assert.match(mbt, /pub let input_right_offset : Int = 0x20000/);
+  assert.match(mbt, /pub let output_right_offset : Int = 0x40000/);
+  assert.match(mbt, /pub let string_buf_offset : Int = 0x50000/);
+  assert.match(mbt, /pub let chorus_mem_base_ptr : Int = 0x50100/);
+  assert.match(mbt, /pub let reverb_mem_base_ptr : Int = 0x50180/);
+  assert.match(mbt, /pub let reverb_mem_bytes : Int = 4096/);
+  assert.match(worklet, /this\.CHANNEL_STRIDE_BYTES = 0x10000/);
+  assert.match(worklet, /this\.OUTPUT_BASE_OFFSET = 0x30000/);
+  assert.match(
+    worklet,
+    /    \/\/ AUTO-GENERATED by scripts\/gen-memory-layout\.js \(next 3 lines\)\. DO NOT EDIT\.\n    this\.CHANNEL_STRIDE_BYTES/,
+  );
+  assert.match(cpp, /static constexpr int MAX_CHANNELS = 2;/);
+  assert.match(cpp, /static constexpr int INPUT_BASE_OFFSET = 0x10000;/);
+  assert.match(cpp, /constexpr int outputChannelOffset \(int channel\)/);
   assert.match(cpp, /static constexpr int MAX_BUFFER_SAMPLES = 16384;/);
+  assert.match(cpp, /static constexpr int STRING_BUF_BYTES = 256;/);
+  assert.match(cpp, /static constexpr int HEAP_START_ADDRESS = 0x60000;/);
+  assert.equal(moonPkg, '{\r\n  "link": {\r\n    "wasm": {\r\n      "heap-start-address": 393216\r\n    }\r\n  }\r\n}\r\n');
+  assert.match(nativeMemory, /#define MOONVST_NATIVE_ARENA_BYTES 393216\n/);
+
+  // A second run keeps a single marker and leaves the outputs current.
+  runGenMemoryLayout({ rootDir: tmpRoot, check: false });
+  const rerun = fs.readFileSync(path.join(workletDir, 'processor.js'), 'utf8');
+  assert.equal(rerun, worklet);
+  runGenMemoryLayout({ rootDir: tmpRoot, check: true });
 });
 
 test('runGenMemoryLayout --check fails when outputs are stale', () => {
@@ -92,23 +157,12 @@ test('runGenMemoryLayout --check fails when outputs are stale', () => {
   fs.mkdirSync(workletDir, { recursive: true });
   fs.mkdirSync(pluginIncludeDir, { recursive: true });
 
-  fs.writeFileSync(path.join(contractsDir, 'memory-layout.json'), JSON.stringify({
-    bytes_per_sample: 4,
-    max_buffer_samples: 16384,
-    offsets: {
-      input_left: 0x10000,
-      input_right: 0x20000,
-      output_left: 0x30000,
-      output_right: 0x40000,
-      string_buf: 0x50000,
-      reverb_mem_base_ptr: 0x60000,
-      chorus_mem_base_ptr: 0x78000,
-    },
-  }, null, 2));
+  fs.writeFileSync(path.join(contractsDir, 'memory-layout.json'), JSON.stringify(contract(), null, 2));
 
   fs.writeFileSync(path.join(dspUtilsDir, 'constants.mbt'), [
     'let sample_rate_hz_box : Array[Float] = [48000.0]',
     '',
+    'pub let max_channels : Int = 0',
     'pub let input_left_offset : Int = 123',
     'pub let input_right_offset : Int = 456',
     'pub let output_left_offset : Int = 789',
@@ -123,18 +177,141 @@ test('runGenMemoryLayout --check fails when outputs are stale', () => {
   fs.writeFileSync(path.join(workletDir, 'processor.js'), [
     'class MoonVSTProcessor extends AudioWorkletProcessor {',
     '  constructor() {',
-    '    this.INPUT_LEFT_OFFSET = 123',
-    '    this.INPUT_RIGHT_OFFSET = 456',
-    '    this.OUTPUT_LEFT_OFFSET = 789',
-    '    this.OUTPUT_RIGHT_OFFSET = 987',
+    '    this.CHANNEL_STRIDE_BYTES = 123',
+    '    this.INPUT_BASE_OFFSET = 456',
+    '    this.OUTPUT_BASE_OFFSET = 789',
     '  }',
     '}',
     '',
   ].join('\n'));
   fs.writeFileSync(path.join(pluginIncludeDir, 'memory_layout_gen.h'), '// stale\n');
+  writeDspPackageFixtures(tmpRoot);
 
   assert.throws(
     () => runGenMemoryLayout({ rootDir: tmpRoot, check: true }),
     /stale|out of date/i,
   );
 });
+
+test('runGenMemoryLayout rejects channel blocks that overlap', () => {
+  const tmpRoot = writeContractOnly('moonvst-layout-overlap-', contract({
+    max_channels: 4,
+    regions: [
+      { name: 'input', offset: 0x10000 },
+      { name: 'output', offset: 0x30000 },
+      { name: 'string_buf', bytes: 256 },
+      { name: 'chorus_mem', bytes: 100 },
+      { name: 'reverb_mem', bytes: 0x1000 },
+    ],
+  }));
+
+  assert.throws(
+    () => runGenMemoryLayout({ rootDir: tmpRoot, check: true }),
+    /regions input and output overlap/i,
+  );
+});
+
+test('runGenMemoryLayout rejects a pinned region inside an effect footprint', () => {
+  const tmpRoot = writeContractOnly('moonvst-layout-footprint-', contract({
+    regions: [
+      { name: 'input' },
+      { name: 'output' },
+      { name: 'string_buf', bytes: 256 },
+      { name: 'chorus_mem', bytes: 0x2000 },
+      { name: 'reverb_mem', bytes: 0x1000, offset: 0x51000 },
+    ],
+  }));
+
+  assert.throws(
+    () => runGenMemoryLayout({ rootDir: tmpRoot, check: true }),
+    /regions chorus_mem and reverb_mem overlap/i,
+  );
+});
+
+test('runGenMemoryLayout rejects misaligned or incomplete contracts', () => {
+  const misaligned = writeContractOnly('moonvst-layout-align-', contract({
+    regions: [
+      { name: 'input', offset: 0x10010 },
+      { name: 'output' },
+      { name: 'string_buf', bytes: 256 },
+      { name: 'chorus_mem', bytes: 100 },
+      { name: 'reverb_mem', bytes: 0x1000 },
+    ],
+  }));
+  assert.throws(() => runGenMemoryLayout({ rootDir: misaligned, check: true }), /multiple of 64/);
+
+  const missing = writeContractOnly('moonvst-layout-missing-', contract({
+    regions: [{ name: 'input' }, { name: 'output' }],
+  }));
+  assert.throws(() => runGenMemoryLayout({ rootDir: missing, check: true }), /missing region string_buf/);
+});
+
+function writeProductLayoutFixtures(prefix, productConfig) {
+  const tmpRoot = writeContractOnly(prefix, contract({ max_channels: 12 }));
+  const dspUtilsDir = path.join(tmpRoot, 'packages', 'dsp-core', 'src', 'utils');
+  const workletDir = path.join(tmpRoot, 'packages', 'ui-core', 'public', 'worklet');
+  const productDir = path.join(tmpRoot, 'products', 'stereo');
+  fs.mkdirSync(dspUtilsDir, { recursive: true });
+  fs.mkdirSync(workletDir, { recursive: true });
+  fs.mkdirSync(productDir, { recursive: true });
+
+  fs.writeFileSync(path.join(dspUtilsDir, 'constants.mbt'), [
+    'pub let max_channels : Int = 0',
+    '',
+    'pub fn set_sample_rate(sample_rate_hz : Float) -> Unit {',
+    '}',
+    '',
+  ].join('\n'));
+  fs.writeFileSync(path.join(workletDir, 'processor.js'), [
+    '    this.CHANNEL_STRIDE_BYTES = 1',
+    '    this.INPUT_BASE_OFFSET = 2',
+    '    this.OUTPUT_BASE_OFFSET = 3',
+    '',
+  ].join('\n'));
+  writeDspPackageFixtures(tmpRoot);
+  // Product configs are saved with a UTF-8 BOM.
+  fs.writeFileSync(path.join(productDir, 'product.config.json'), `\uFEFF${JSON.stringify(productConfig, null, 2)}`);
+  return tmpRoot;
+}
+
+function generatedHeader(tmpRoot) {
+  return fs.readFileSync(path.join(tmpRoot, 'plugin', 'include', 'moonvst', 'memory_layout_gen.h'), 'utf8');
+}
+
+test('runGenMemoryLayout sizes the channel blocks to the product audio.maxChannels', () => {
+  const tmpRoot = writeProductLayoutFixtures('moonvst-layout-product-', { name: 'stereo', audio: { maxChannels: 2 } });
+
+  runGenMemoryLayout({ rootDir: tmpRoot, product: 'stereo', check: false });
+  const stereo = generatedHeader(tmpRoot);
+  assert.match(stereo, /static constexpr int MAX_CHANNELS = 2;/);
+  assert.match(stereo, /static constexpr int OUTPUT_BASE_OFFSET = 0x30000;/);
+  assert.match(stereo, /static constexpr int HEAP_START_ADDRESS = 0x60000;/);
+  const moonPkg = fs.readFileSync(path.join(tmpRoot, 'packages', 'dsp-core', 'src', 'moon.pkg.json'), 'utf8');
+  assert.match(moonPkg, /"heap-start-address": 393216/);
+  runGenMemoryLayout({ rootDir: tmpRoot, product: 'stereo', check: true });
+
+  // A product without a config keeps the contract's full channel count.
+  assert.throws(() => runGenMemoryLayout({ rootDir: tmpRoot, product: 'template', check: true }), /stale/);
+  runGenMemoryLayout({ rootDir: tmpRoot, product: 'template', check: false });
+  const full = generatedHeader(tmpRoot);
+  assert.match(full, /static constexpr int MAX_CHANNELS = 12;/);
+  assert.match(full, /static constexpr int OUTPUT_BASE_OFFSET = 0xD0000;/);
+  assert.match(full, /static constexpr int HEAP_START_ADDRESS = 0x1A0000;/);
+});
+
+test('runGenMemoryLayout keeps a product channel cap within the stereo pair and the contract', () => {
+  const mono = writeProductLayoutFixtures('moonvst-layout-mono-', { audio: { maxChannels: 1 } });
+  runGenMemoryLayout({ rootDir: mono, product: 'stereo', check: false });
+  assert.match(generatedHeader(mono), /static constexpr int MAX_CHANNELS = 2;/);
+
+  const wide = writeProductLayoutFixtures('moonvst-layout-wide-', { audio: { maxChannels: 24 } });
+  runGenMemoryLayout({ rootDir: wide, product: 'stereo', check: false });
+  assert.match(generatedHeader(wide), /static constexpr int MAX_CHANNELS = 12;/);
+
+  const invalid = writeProductLayoutFixtures('moonvst-layout-invalid-', { audio: { maxChannels: '2' } });
+  assert.throws(
+    () => runGenMemoryLayout({ rootDir: invalid, product: 'stereo', check: true }),
+    /audio\.maxChannels must be a positive integer/,
+  );
+  assert.throws(() => runGenMemoryLayout({ rootDir: invalid, product: '../stereo', check: true }), /invalid product name/);
+});
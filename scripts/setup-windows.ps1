@@ -34,7 +34,10 @@ New-Item -ItemType Directory -Force -Path "$WamrPlatform/build" | Out-Null
 Set-Location "$WamrPlatform/build"
 cmake .. `
     -DWAMR_BUILD_AOT=1 `
-    -DWAMR_BUILD_INTERP=0 `
+    -DWAMR_BUILD_INTERP=1 `
+    -DWAMR_BUILD_FAST_INTERP=1 `
+    -DWAMR_BUILD_THREAD_MGR=1 `
+    -DWAMR_BUILD_SHARED_MEMORY=1 `
     -DWAMR_BUILD_LIBC_BUILTIN=1 `
     -DWAMR_BUILD_LIBC_WASI=0 `
     -DWAMR_DISABLE_HW_BOUND_CHECK=1
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "moonvst/NativeDSP.h"
+#include "moonvst/WasmDSP.h"
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+// Side-by-side throughput of the available DSP backends, aggregate throughput
+// of N WasmDSP instances on N threads, and the plugin's direct and fixed-block
+// processing modes at small host buffers.
+// Not registered with CTest; run `dsp_benchmark` directly from the build dir.
+
+namespace
+{
+constexpr double kSampleRate = 48000.0;
+constexpr double kSecondsOfAudio = 20.0;
+constexpr int kScalingBlockSize = 128;
+constexpr int kMaxScalingThreads = 64;
+
+void runBenchmark(DSPBackend& dsp, int blockSize)
+{
+    dsp.prepare(kSampleRate, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < blockSize; ++i)
+            buffer.setSample(ch, i, 0.25f * (float)((i * 7 + ch * 3) % 17) / 17.0f);
+
+    std::vector<float> paramValues((size_t)dsp.getParamCount());
+    for (size_t p = 0; p < paramValues.size(); ++p)
+        paramValues[p] = dsp.getParamDefault((int)p);
+
+    const int numBlocks = (int)(kSecondsOfAudio * kSampleRate) / blockSize;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        // Mirror PluginProcessor, which pushes every parameter each block.
+        for (size_t p = 0; p < paramValues.size(); ++p)
+            dsp.setParam((int)p, paramValues[p]);
+        dsp.processBlock(buffer);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double nsPerSample = elapsed * 1.0e9 / ((double)numBlocks * blockSize);
+    printf("%-14s block %4d: %8.2f ns/sample  %8.1fx realtime\n",
+           dsp.getBackendName(), blockSize, nsPerSample, kSecondsOfAudio / elapsed);
+}
+
+// Runs one WasmDSP per thread, the way a host spreads plugin instances over
+// its audio worker pool, and returns the aggregate samples per second. The
+// instances are set up on the main thread and processed on the workers, so
+// per-thread runtime setup is part of what gets measured.
+double runScalingBenchmark(int numThreads)
+{
+    std::vector<std::unique_ptr<WasmDSP>> instances;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        auto dsp = std::make_unique<WasmDSP>();
+        if (!dsp->initialize())
+            return 0.0;
+        dsp->prepare(kSampleRate, kScalingBlockSize);
+        instances.push_back(std::move(dsp));
+    }
+
+    const int numBlocks = (int)(kSecondsOfAudio * kSampleRate) / kScalingBlockSize;
+    std::atomic<int> ready { 0 };
+    std::atomic<bool> go { false };
+    std::vector<std::thread> workers;
+
+    for (auto& instance : instances)
+    {
+        workers.emplace_back([&ready, &go, numBlocks, dsp = instance.get()]
+        {
+            juce::AudioBuffer<float> buffer(2, kScalingBlockSize);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < kScalingBlockSize; ++i)
+                    buffer.setSample(ch, i, 0.25f * (float)((i * 7 + ch * 3) % 17) / 17.0f);
+
+            std::vector<float> paramValues((size_t)dsp->getParamCount());
+            for (size_t p = 0; p < paramValues.size(); ++p)
+                paramValues[p] = dsp->getParamDefault((int)p);
+
+            ready.fetch_add(1);
+            while (!go.load())
+                std::this_thread::yield();
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                for (size_t p = 0; p < paramValues.size(); ++p)
+                    dsp->setParam((int)p, paramValues[p]);
+                dsp->processBlock(buffer);
+            }
+        });
+    }
+
+    while (ready.load() < numThreads)
+        std::this_thread::yield();
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true);
+    for (auto& worker : workers)
+        worker.join();
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return (double)numThreads * numBlocks * kScalingBlockSize / elapsed;
+}
+
+// Whole PluginProcessor::processBlock, so the per-call parameter sync is
+// included; that is what fixed-block mode amortises.
+void runProcessorBenchmark(PluginProcessor& plugin, int blockSize, bool fixedBlock)
+{
+    plugin.setFixedBlockProcessing(fixedBlock);
+    plugin.prepareToPlay(kSampleRate, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    const int numBlocks = (int)(kSecondsOfAudio * kSampleRate) / blockSize;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                buffer.setSample(ch, i, 0.25f * (float)(((block * blockSize + i) * 7 + ch * 3) % 17) / 17.0f);
+        plugin.processBlock(buffer, midi);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double nsPerSample = elapsed * 1.0e9 / ((double)numBlocks * blockSize);
+    printf("%-14s block %4d: %8.2f ns/sample  %8.1fx realtime  latency %d\n",
+           fixedBlock ? "fixed-128" : "direct", blockSize, nsPerSample,
+           kSecondsOfAudio / elapsed, plugin.getLatencySamples());
+}
+}
+
+int main()
+{
+    printf("=== DSP Backend Benchmark ===\n");
+
+    // One WasmDSP per execution mode, so AOT, JIT and interpreter numbers line up.
+    std::vector<std::unique_ptr<DSPBackend>> backends;
+    std::vector<WasmExecutionMode> requestedModes;
+    for (const auto mode : { WasmExecutionMode::aot, WasmExecutionMode::llvmJit,
+                             WasmExecutionMode::fastJit, WasmExecutionMode::interpreter })
+    {
+        if (!WasmDSP::isExecutionModeSupported(mode))
+        {
+            printf("SKIP: wasm %s mode not built into WAMR\n", WasmDSP::getExecutionModeName(mode));
+            continue;
+        }
+        backends.push_back(std::make_unique<WasmDSP>(mode));
+        requestedModes.push_back(mode);
+    }
+    if (NativeDSP::isAvailable())
+        backends.push_back(std::make_unique<NativeDSP>());
+
+    for (size_t i = 0; i < backends.size(); ++i)
+    {
+        auto& dsp = backends[i];
+        if (!dsp->initialize())
+        {
+            printf("SKIP: %s backend unavailable\n", dsp->getBackendName());
+            continue;
+        }
+
+        // A mode that failed to load falls back to the next one; don't report it twice.
+        if (auto* wasm = dynamic_cast<WasmDSP*>(dsp.get());
+            wasm != nullptr && wasm->getExecutionMode() != requestedModes[i])
+        {
+            printf("SKIP: wasm %s mode fell back to %s\n",
+                   WasmDSP::getExecutionModeName(requestedModes[i]), dsp->getBackendName());
+            continue;
+        }
+
+        for (const int blockSize : { 32, 128, 512 })
+            runBenchmark(*dsp, blockSize);
+    }
+
+    printf("=== Multi-Instance Scaling ===\n");
+    // Threads beyond the core count only measure the scheduler.
+    const int maxThreads = std::min((int)std::max(1u, std::thread::hardware_concurrency()), kMaxScalingThreads);
+    std::vector<int> threadCounts;
+    for (int n = 1; n < maxThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    double singleThreadRate = 0.0;
+    for (const int numThreads : threadCounts)
+    {
+        const double rate = runScalingBenchmark(numThreads);
+        if (rate <= 0.0)
+        {
+            printf("SKIP: wasm backend unavailable for %d instances\n", numThreads);
+            break;
+        }
+        if (numThreads == 1)
+            singleThreadRate = rate;
+
+        printf("%3d threads: %10.2f Msamples/s  %8.1fx realtime  %5.1f%% scaling efficiency\n",
+               numThreads, rate / 1.0e6, rate / kSampleRate,
+               100.0 * rate / (singleThreadRate * numThreads));
+    }
+
+    printf("=== Host Buffer Rebuffering ===\n");
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    auto processor = std::unique_ptr<juce::AudioProcessor>(createPluginFilter());
+    auto* plugin = dynamic_cast<PluginProcessor*>(processor.get());
+    if (plugin == nullptr)
+    {
+        printf("SKIP: PluginProcessor unavailable\n");
+        return 0;
+    }
+
+    for (const int blockSize : { 16, 32, 64, 128 })
+        for (const bool fixedBlock : { false, true })
+            runProcessorBenchmark(*plugin, blockSize, fixedBlock);
+
+    return 0;
+}
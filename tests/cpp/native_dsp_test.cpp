@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "moonvst/NativeDSP.h"
+#include "moonvst/WasmDSP.h"
+
+// Bit-exactness check: the native (C backend) DSP core must produce the same
+// samples as the AOT module for identical input and parameter sequences.
+
+namespace
+{
+void fillInput(juce::AudioBuffer<float>& buffer, int blockIndex, uint32_t& seed)
+{
+    const int numSamples = buffer.getNumSamples();
+    for (int i = 0; i < numSamples; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const float noise = ((float)(seed >> 8) / 16777216.0f) * 2.0f - 1.0f;
+        const float phase = (float)(blockIndex * numSamples + i) * 0.0261799f;
+        buffer.setSample(0, i, 0.5f * std::sin(phase) + 0.1f * noise);
+        buffer.setSample(1, i, 0.5f * std::cos(phase) - 0.1f * noise);
+    }
+}
+}
+
+int main()
+{
+    printf("=== NativeDSP Bit-Exactness Test ===\n");
+    constexpr int kBlockSize = 128;
+    constexpr int kNumBlocks = 400;
+
+    WasmDSP wasm;
+    if (!wasm.initialize())
+    {
+        printf("SKIP: AOT module unavailable (run build:dsp first)\n");
+        return 0;
+    }
+
+    NativeDSP native;
+    if (!native.initialize())
+    {
+        printf("FAIL: NativeDSP failed to initialize\n");
+        return 1;
+    }
+    printf("PASS: Both backends initialized\n");
+
+    const int paramCount = wasm.getParamCount();
+    if (paramCount != native.getParamCount())
+    {
+        printf("FAIL: param count mismatch (wasm %d, native %d)\n", paramCount, native.getParamCount());
+        return 1;
+    }
+    for (int i = 0; i < paramCount; ++i)
+    {
+        if (wasm.getParamName(i) != native.getParamName(i)
+            || wasm.getParamDefault(i) != native.getParamDefault(i))
+        {
+            printf("FAIL: param %d metadata mismatch\n", i);
+            return 1;
+        }
+    }
+    printf("PASS: Parameter metadata matches (%d params)\n", paramCount);
+
+    wasm.prepare(48000.0, kBlockSize);
+    native.prepare(48000.0, kBlockSize);
+
+    juce::AudioBuffer<float> wasmBuffer(2, kBlockSize);
+    juce::AudioBuffer<float> nativeBuffer(2, kBlockSize);
+    uint32_t seed = 0x2545f491u;
+
+    for (int block = 0; block < kNumBlocks; ++block)
+    {
+        // Sweep every parameter through its range so each code path is exercised.
+        if (block % 50 == 0)
+        {
+            const float t = (float)(block / 50 % 5) / 4.0f;
+            for (int i = 0; i < paramCount; ++i)
+            {
+                const float value = wasm.getParamMin(i) + t * (wasm.getParamMax(i) - wasm.getParamMin(i));
+                wasm.setParam(i, value);
+                native.setParam(i, value);
+            }
+        }
+
+        fillInput(wasmBuffer, block, seed);
+        nativeBuffer.makeCopyOf(wasmBuffer);
+
+        wasm.processBlock(wasmBuffer);
+        native.processBlock(nativeBuffer);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const auto* expected = wasmBuffer.getReadPointer(ch);
+            const auto* actual = nativeBuffer.getReadPointer(ch);
+            if (std::memcmp(expected, actual, sizeof(float) * kBlockSize) != 0)
+            {
+                for (int i = 0; i < kBlockSize; ++i)
+                {
+                    if (std::memcmp(&expected[i], &actual[i], sizeof(float)) != 0)
+                    {
+                        printf("FAIL: block %d ch %d sample %d differs (aot %.9g, native %.9g)\n",
+                               block, ch, i, expected[i], actual[i]);
+                        break;
+                    }
+                }
+                return 1;
+            }
+        }
+    }
+    printf("PASS: %d blocks bit-identical across backends\n", kNumBlocks);
+
+    printf("=== All native DSP checks passed ===\n");
+    return 0;
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <memory>
@@ -5,6 +7,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "PluginProcessor.h"
+#include "PluginEditor.h"
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
 
@@ -40,9 +43,33 @@ int main()
     }
     printf("PASS: processBlock executed\n");
 
+    {
+        // The graph bank is state, not automation: hosts must not list it.
+        int graphBankParams = 0;
+        for (auto* param : plugin->getParameters())
+        {
+            const auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(param);
+            const bool graphBank = withId != nullptr && withId->getParameterID().startsWith("graph_");
+            graphBankParams += graphBank ? 1 : 0;
+            if (param->isAutomatable() == graphBank)
+            {
+                printf("FAIL: parameter %s is %sautomatable\n",
+                       param->getName(64).toRawUTF8(), graphBank ? "" : "not ");
+                return 1;
+            }
+        }
+        printf("PASS: %d graph bank parameters are hidden from host automation\n", graphBankParams);
+    }
+
+    double totalOpenMs = 0.0;
+    double worstOpenMs = 0.0;
     for (int i = 0; i < kEditorOpenCloseIterations; ++i)
     {
+        const auto openStart = std::chrono::steady_clock::now();
         auto* editor = plugin->createEditor();
+        const double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - openStart).count();
+        totalOpenMs += openMs;
+        worstOpenMs = std::max(worstOpenMs, openMs);
         if (editor == nullptr)
         {
             printf("FAIL: createEditor returned null at iteration %d\n", i + 1);
@@ -64,6 +91,53 @@ int main()
     }
     printf("PASS: Editor open/close stress (%d iterations)\n",
            kEditorOpenCloseIterations);
+    printf("INFO: editor open latency mean %.3f ms, worst %.3f ms\n",
+           totalOpenMs / kEditorOpenCloseIterations, worstOpenMs);
+
+    {
+        // Cost of a full parameter sweep with an editor open whose UI has
+        // subscribed to every parameter, i.e. the per-change listener
+        // overhead the editor adds to automation at worst.
+        std::unique_ptr<juce::AudioProcessorEditor> editor(plugin->createEditor());
+        auto* typedEditor = dynamic_cast<PluginEditor*>(editor.get());
+        if (typedEditor == nullptr)
+        {
+            printf("FAIL: createEditor did not return a PluginEditor\n");
+            return 1;
+        }
+
+        // Listeners are attached only for what the UI subscribes to.
+        if (typedEditor->getParamListenerCount() != 0)
+        {
+            printf("FAIL: editor attached %d parameter listeners before any UI subscription\n",
+                   typedEditor->getParamListenerCount());
+            return 1;
+        }
+
+        const auto& params = plugin->getParameters();
+        juce::Array<juce::var> indices;
+        for (int i = 0; i < params.size(); ++i)
+            indices.add(i);
+        const auto subscribed = typedEditor->subscribeParams(juce::var(indices));
+        const int listeners = typedEditor->getParamListenerCount();
+        if (listeners != params.size() || subscribed.size() != params.size())
+        {
+            printf("FAIL: subscribing %d parameters attached %d listeners and returned %d values\n",
+                   params.size(), listeners, subscribed.size());
+            return 1;
+        }
+        printf("PASS: UI subscription attached %d parameter listeners\n", listeners);
+
+        constexpr int kSweeps = 20;
+        const auto sweepStart = std::chrono::steady_clock::now();
+        for (int sweep = 0; sweep < kSweeps; ++sweep)
+            for (auto* param : params)
+                param->setValueNotifyingHost((float)(sweep % 2));
+        const double sweepUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sweepStart).count();
+        const int changes = kSweeps * params.size();
+        printf("INFO: parameter change with %d UI listeners: %.3f us/change over %d changes\n",
+               listeners, changes > 0 ? sweepUs / changes : 0.0, changes);
+    }
 
     plugin->releaseResources();
 
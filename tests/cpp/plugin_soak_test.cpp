@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+// Deadline soak: drives PluginProcessor::processBlock for minutes of simulated
+// audio while randomly mutating the showcase graph through the parameter bank,
+// and reports every block that overran its real-time deadline.
+// Not registered with CTest; run `plugin_soak_test` directly from the build dir.
+//
+//   MOONVST_SOAK_SECONDS     simulated seconds per block size (default 60)
+//   MOONVST_SOAK_SEED        RNG seed for the mutation sequence (default 1)
+//   MOONVST_SOAK_MAX_MISSES  fail when total deadline misses exceed this
+
+namespace
+{
+constexpr double kSampleRate = 48000.0;
+constexpr int kMaxNodes = 128;
+constexpr int kMaxEdges = 256;
+constexpr int kEffectTypeCount = 8;
+constexpr double kMeanMutationIntervalSec = 0.05;
+constexpr size_t kReportedSpikes = 10;
+
+struct SoakNode
+{
+    int effectType = 0;
+    bool bypass = false;
+    float p1 = 1.0f;
+    float p2 = 0.0f;
+    float p3 = 0.0f;
+};
+
+// The graph is kept as a chain from the input node to the output node plus
+// optional forward skip edges, so every mutation stays acyclic and connected.
+struct SoakGraph
+{
+    std::vector<SoakNode> chain;
+    std::vector<std::pair<int, int>> skips;
+
+    SoakGraph()
+    {
+        SoakNode input;
+        input.bypass = true;
+        SoakNode output;
+        output.bypass = true;
+        chain = { input, output };
+    }
+
+    int nodeCount() const { return (int) chain.size(); }
+    int edgeCount() const { return (int) chain.size() - 1 + (int) skips.size(); }
+
+    // Bank node index for a chain position: input is 0, output is 1, effects follow.
+    int nodeIndexAt (int position) const
+    {
+        if (position == 0)
+            return 0;
+        if (position == nodeCount() - 1)
+            return 1;
+        return position + 1;
+    }
+
+    std::string describe() const
+    {
+        static const char* kTypeNames[kEffectTypeCount] = {
+            "gain", "chorus", "comp", "delay", "dist", "eq", "filter", "reverb"
+        };
+        std::string text = "in";
+        for (int i = 1; i < nodeCount() - 1; ++i)
+        {
+            const auto& node = chain[(size_t) i];
+            text += " -> ";
+            text += kTypeNames[juce::jlimit (0, kEffectTypeCount - 1, node.effectType)];
+            if (node.bypass)
+                text += "(byp)";
+        }
+        text += " -> out";
+        for (const auto& [from, to] : skips)
+            text += " +skip " + std::to_string (from) + ">" + std::to_string (to);
+        return text;
+    }
+};
+
+class GraphParamWriter
+{
+public:
+    explicit GraphParamWriter (juce::AudioProcessor& processor)
+    {
+        for (auto* param : processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (param))
+                params_[ranged->getParameterID().toStdString()] = ranged;
+    }
+
+    bool hasGraphBank() const { return params_.count ("graph_revision") != 0; }
+
+    void write (const SoakGraph& graph)
+    {
+        set ("graph_schema", 1.0f);
+        set ("graph_nodes", (float) graph.nodeCount());
+        set ("graph_edges", (float) graph.edgeCount());
+        set ("graph_has_output_path", 1.0f);
+
+        for (int position = 0; position < graph.nodeCount(); ++position)
+        {
+            const auto& node = graph.chain[(size_t) position];
+            const auto prefix = "graph_node_" + std::to_string (graph.nodeIndexAt (position)) + "_";
+            set (prefix + "effect_type", (float) node.effectType);
+            set (prefix + "bypass", node.bypass ? 1.0f : 0.0f);
+            set (prefix + "p1", node.p1);
+            set (prefix + "p2", node.p2);
+            set (prefix + "p3", node.p3);
+        }
+
+        int edge = 0;
+        const auto writeEdge = [&] (int fromPosition, int toPosition)
+        {
+            const auto prefix = "graph_edge_" + std::to_string (edge++) + "_";
+            set (prefix + "from", (float) graph.nodeIndexAt (fromPosition));
+            set (prefix + "to", (float) graph.nodeIndexAt (toPosition));
+        };
+        for (int position = 0; position + 1 < graph.nodeCount(); ++position)
+            writeEdge (position, position + 1);
+        for (const auto& [from, to] : graph.skips)
+            writeEdge (from, to);
+
+        set ("graph_revision", (float) ++revision_);
+    }
+
+private:
+    void set (const std::string& id, float value)
+    {
+        const auto it = params_.find (id);
+        if (it == params_.end())
+            return;
+        it->second->setValueNotifyingHost (it->second->convertTo0to1 (value));
+    }
+
+    std::map<std::string, juce::RangedAudioParameter*> params_;
+    int revision_ = 0;
+};
+
+class GraphMutator
+{
+public:
+    explicit GraphMutator (uint32_t seed) : rng_ (seed) {}
+
+    std::string mutate (SoakGraph& graph)
+    {
+        switch (pick (0, 4))
+        {
+            case 0:  return addNode (graph);
+            case 1:  return removeNode (graph);
+            case 2:  return rewire (graph);
+            case 3:  return toggleBypass (graph);
+            default: return tweak (graph);
+        }
+    }
+
+    int pick (int lo, int hi) { return std::uniform_int_distribution<int> (lo, hi) (rng_); }
+    float unit() { return std::uniform_real_distribution<float> (0.0f, 1.0f) (rng_); }
+    double exponential (double mean) { return std::exponential_distribution<double> (1.0 / mean) (rng_); }
+
+private:
+    int effectCount (const SoakGraph& graph) const { return graph.nodeCount() - 2; }
+
+    std::string addNode (SoakGraph& graph)
+    {
+        if (graph.nodeCount() >= kMaxNodes || graph.edgeCount() >= kMaxEdges)
+            return removeNode (graph);
+
+        SoakNode node;
+        node.effectType = pick (0, kEffectTypeCount - 1);
+        node.p1 = unit();
+        node.p2 = unit();
+        node.p3 = unit();
+        const int position = pick (1, graph.nodeCount() - 1);
+        graph.chain.insert (graph.chain.begin() + position, node);
+        for (auto& [from, to] : graph.skips)
+        {
+            if (from >= position)
+                ++from;
+            if (to >= position)
+                ++to;
+        }
+        return "add node at " + std::to_string (position);
+    }
+
+    std::string removeNode (SoakGraph& graph)
+    {
+        if (effectCount (graph) == 0)
+            return addNode (graph);
+
+        const int position = pick (1, graph.nodeCount() - 2);
+        graph.chain.erase (graph.chain.begin() + position);
+        std::vector<std::pair<int, int>> kept;
+        for (auto [from, to] : graph.skips)
+        {
+            if (from == position || to == position)
+                continue;
+            if (from > position)
+                --from;
+            if (to > position)
+                --to;
+            if (to - from > 1)
+                kept.emplace_back (from, to);
+        }
+        graph.skips = kept;
+        return "remove node at " + std::to_string (position);
+    }
+
+    std::string rewire (SoakGraph& graph)
+    {
+        if (! graph.skips.empty() && pick (0, 1) == 0)
+        {
+            graph.skips.erase (graph.skips.begin() + pick (0, (int) graph.skips.size() - 1));
+            return "drop skip edge";
+        }
+        if (graph.nodeCount() >= 3 && graph.edgeCount() < kMaxEdges)
+        {
+            const int from = pick (0, graph.nodeCount() - 3);
+            const int to = pick (from + 2, graph.nodeCount() - 1);
+            graph.skips.emplace_back (from, to);
+            return "add skip edge " + std::to_string (from) + ">" + std::to_string (to);
+        }
+        return addNode (graph);
+    }
+
+    std::string toggleBypass (SoakGraph& graph)
+    {
+        if (effectCount (graph) == 0)
+            return addNode (graph);
+
+        auto& node = graph.chain[(size_t) pick (1, graph.nodeCount() - 2)];
+        node.bypass = ! node.bypass;
+        return node.bypass ? "bypass node" : "enable node";
+    }
+
+    std::string tweak (SoakGraph& graph)
+    {
+        if (effectCount (graph) == 0)
+            return addNode (graph);
+
+        auto& node = graph.chain[(size_t) pick (1, graph.nodeCount() - 2)];
+        node.p1 = unit();
+        node.p2 = unit();
+        node.p3 = unit();
+        return "tweak params";
+    }
+
+    std::mt19937 rng_;
+};
+
+struct Spike
+{
+    double ms = 0.0;
+    double atSec = 0.0;
+    int blockSize = 0;
+    std::string mutation;
+    std::string graph;
+};
+
+struct SoakReport
+{
+    long long blocks = 0;
+    long long misses = 0;
+    long long nonFinite = 0;
+    double worstMs = 0.0;
+    std::vector<Spike> spikes;
+
+    void record (const Spike& spike, bool missed)
+    {
+        ++blocks;
+        if (missed)
+            ++misses;
+        worstMs = std::max (worstMs, spike.ms);
+
+        if (spikes.size() < kReportedSpikes || spike.ms > spikes.back().ms)
+        {
+            spikes.push_back (spike);
+            std::sort (spikes.begin(), spikes.end(), [] (const Spike& a, const Spike& b) { return a.ms > b.ms; });
+            if (spikes.size() > kReportedSpikes)
+                spikes.pop_back();
+        }
+    }
+};
+
+bool hasNonFiniteSample (const juce::AudioBuffer<float>& buffer)
+{
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            if (! std::isfinite (buffer.getSample (ch, i)))
+                return true;
+    return false;
+}
+
+double envDouble (const char* name, double fallback)
+{
+    const char* value = std::getenv (name);
+    return value != nullptr && *value != '\0' ? std::atof (value) : fallback;
+}
+
+void runSoak (juce::AudioProcessor& plugin, int blockSize, double seconds, uint32_t seed, SoakReport& report)
+{
+    plugin.setPlayConfigDetails (2, 2, kSampleRate, blockSize);
+    plugin.prepareToPlay (kSampleRate, blockSize);
+
+    GraphParamWriter writer (plugin);
+    GraphMutator mutator (seed);
+    SoakGraph graph;
+    writer.write (graph);
+
+    juce::AudioBuffer<float> buffer (2, blockSize);
+    juce::MidiBuffer midi;
+    std::minstd_rand noise (seed);
+    std::uniform_real_distribution<float> sample (-0.25f, 0.25f);
+
+    const double deadlineMs = 1000.0 * blockSize / kSampleRate;
+    const long long numBlocks = (long long) (seconds * kSampleRate) / blockSize;
+    double nextMutationSec = mutator.exponential (kMeanMutationIntervalSec);
+    std::string lastMutation = "initial graph";
+    long long phaseMisses = 0;
+    double phaseWorstMs = 0.0;
+
+    for (long long block = 0; block < numBlocks; ++block)
+    {
+        const double nowSec = (double) block * blockSize / kSampleRate;
+        if (nowSec >= nextMutationSec)
+        {
+            lastMutation = mutator.mutate (graph);
+            writer.write (graph);
+            nextMutationSec = nowSec + mutator.exponential (kMeanMutationIntervalSec);
+        }
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                buffer.setSample (ch, i, sample (noise));
+
+        const auto start = std::chrono::steady_clock::now();
+        plugin.processBlock (buffer, midi);
+        const double ms = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now() - start).count();
+
+        if (hasNonFiniteSample (buffer))
+            ++report.nonFinite;
+
+        const bool missed = ms > deadlineMs;
+        if (missed)
+            ++phaseMisses;
+        phaseWorstMs = std::max (phaseWorstMs, ms);
+        report.record ({ ms, nowSec, blockSize, lastMutation, graph.describe() }, missed);
+    }
+
+    plugin.releaseResources();
+    printf("block %4d: %lld blocks, %lld deadline misses, worst %.3f ms (deadline %.3f ms)\n",
+           blockSize, numBlocks, phaseMisses, phaseWorstMs, deadlineMs);
+}
+}
+
+int main()
+{
+    printf("=== Plugin Deadline Soak Test ===\n");
+
+    const double seconds = envDouble ("MOONVST_SOAK_SECONDS", 60.0);
+    const auto seed = (uint32_t) envDouble ("MOONVST_SOAK_SEED", 1.0);
+    const double maxMisses = envDouble ("MOONVST_SOAK_MAX_MISSES", -1.0);
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    auto plugin = std::unique_ptr<juce::AudioProcessor> (createPluginFilter());
+    if (plugin == nullptr)
+    {
+        printf("FAIL: createPluginFilter returned null\n");
+        return 1;
+    }
+
+    if (! GraphParamWriter (*plugin).hasGraphBank())
+    {
+        printf("SKIP: product has no graph parameter bank (build with MOONVST_PRODUCT=showcase)\n");
+        return 0;
+    }
+
+    printf("seed %u, %.0f s simulated per block size\n", seed, seconds);
+
+    SoakReport report;
+    for (const int blockSize : { 64, 128, 256, 512 })
+        runSoak (*plugin, blockSize, seconds, seed, report);
+
+    printf("\n%lld blocks, %lld deadline misses, worst %.3f ms\n", report.blocks, report.misses, report.worstMs);
+    printf("slowest blocks:\n");
+    for (const auto& spike : report.spikes)
+        printf("  %8.3f ms  block %4d  t=%8.3f s  after '%s'\n             %s\n",
+               spike.ms, spike.blockSize, spike.atSec, spike.mutation.c_str(), spike.graph.c_str());
+
+    if (report.nonFinite > 0)
+    {
+        printf("FAIL: %lld blocks produced non-finite samples\n", report.nonFinite);
+        return 1;
+    }
+    if (maxMisses >= 0.0 && (double) report.misses > maxMisses)
+    {
+        printf("FAIL: %lld deadline misses exceed MOONVST_SOAK_MAX_MISSES=%.0f\n", report.misses, maxMisses);
+        return 1;
+    }
+
+    printf("PASS: soak completed\n");
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include "PluginStateCodec.h"
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+// Save/restore cost of the binary plugin state against the legacy XML format,
+// across a session of 500 distinct instances.
+
+namespace
+{
+constexpr int kInstanceCount = 500;
+
+double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void createLegacyXmlState(PluginProcessor& processor, const juce::String& uiStateJson, juce::MemoryBlock& destData)
+{
+    auto state = processor.getAPVTS().copyState();
+    state.setProperty("uiStateJson", uiStateJson, nullptr);
+    std::unique_ptr<juce::XmlElement> xml(state.createXml());
+    juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+}
+
+bool paramsMatch(PluginProcessor& expected, PluginProcessor& actual)
+{
+    for (int i = 0; i < expected.getWasmParamCount(); ++i)
+    {
+        const auto& name = expected.getWasmParamName(i);
+        const auto* expectedValue = expected.getAPVTS().getRawParameterValue(name);
+        const auto* actualValue = actual.getAPVTS().getRawParameterValue(name);
+        if (expectedValue == nullptr || actualValue == nullptr)
+            return false;
+        if (std::abs(expectedValue->load() - actualValue->load()) > 1.0e-6f)
+        {
+            printf("  param %s: expected %f, got %f\n", name.c_str(), expectedValue->load(), actualValue->load());
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+int main()
+{
+    printf("=== Plugin State Test ===\n");
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    auto source = std::unique_ptr<juce::AudioProcessor>(createPluginFilter());
+    auto target = std::unique_ptr<juce::AudioProcessor>(createPluginFilter());
+    auto* typedSource = dynamic_cast<PluginProcessor*>(source.get());
+    auto* typedTarget = dynamic_cast<PluginProcessor*>(target.get());
+    if (typedSource == nullptr || typedTarget == nullptr)
+    {
+        printf("FAIL: PluginProcessor cast failed\n");
+        return 1;
+    }
+
+    // Move every parameter away from its default so restore has real work to do.
+    const auto& params = source->getParameters();
+    for (int i = 0; i < params.size(); ++i)
+        params[i]->setValueNotifyingHost((float)((i * 37) % 100) / 100.0f);
+
+    juce::String uiStateJson = R"({"version":1,"lastPresetName":"State","graphPayload":")";
+    for (int i = 0; i < 200; ++i)
+        uiStateJson << "node-" << i << ";";
+    uiStateJson << R"("})";
+    typedSource->setUiStateJson(uiStateJson);
+
+    juce::MemoryBlock binaryState;
+    source->getStateInformation(binaryState);
+    juce::MemoryBlock legacyState;
+    createLegacyXmlState(*typedSource, uiStateJson, legacyState);
+
+    printf("INFO: state size binary %d bytes, legacy xml %d bytes\n",
+           (int)binaryState.getSize(), (int)legacyState.getSize());
+    if (binaryState.getSize() >= legacyState.getSize())
+    {
+        printf("FAIL: binary state is not smaller than the legacy XML state\n");
+        return 1;
+    }
+    printf("PASS: Binary state is more compact than XML\n");
+
+    target->setStateInformation(binaryState.getData(), (int)binaryState.getSize());
+    if (!paramsMatch(*typedSource, *typedTarget) || typedTarget->getUiStateJson() != uiStateJson)
+    {
+        printf("FAIL: binary state did not roundtrip\n");
+        return 1;
+    }
+    printf("PASS: Binary state roundtrip\n");
+
+    typedSource->setFixedBlockProcessing(true);
+    juce::MemoryBlock fixedBlockState;
+    source->getStateInformation(fixedBlockState);
+    typedSource->setFixedBlockProcessing(false);
+    target->setStateInformation(fixedBlockState.getData(), (int)fixedBlockState.getSize());
+    if (!typedTarget->isFixedBlockProcessing()
+        || target->getLatencySamples() != PluginProcessor::fixedBlockSamples)
+    {
+        printf("FAIL: fixed-block mode did not roundtrip with its latency\n");
+        return 1;
+    }
+    target->setStateInformation(binaryState.getData(), (int)binaryState.getSize());
+    if (typedTarget->isFixedBlockProcessing() || target->getLatencySamples() != 0)
+    {
+        printf("FAIL: state without the fixed-block flag did not clear it\n");
+        return 1;
+    }
+    printf("PASS: Fixed-block mode roundtrip\n");
+
+    auto legacyTarget = std::unique_ptr<juce::AudioProcessor>(createPluginFilter());
+    auto* typedLegacyTarget = dynamic_cast<PluginProcessor*>(legacyTarget.get());
+    legacyTarget->setStateInformation(legacyState.getData(), (int)legacyState.getSize());
+    if (!paramsMatch(*typedSource, *typedLegacyTarget) || typedLegacyTarget->getUiStateJson() != uiStateJson)
+    {
+        printf("FAIL: legacy XML state did not import\n");
+        return 1;
+    }
+    printf("PASS: Legacy XML state import\n");
+
+    // A state from a build whose parameter set differed: reversed order, plus
+    // a parameter this build no longer has. Values must come back by ID.
+    {
+        PluginStateData reordered;
+        std::vector<std::string> names;
+        for (int i = typedSource->getWasmParamCount() - 1; i >= 0; --i)
+        {
+            names.push_back(typedSource->getWasmParamName(i));
+            reordered.paramValues.push_back(typedSource->getAPVTS().getRawParameterValue(names.back())->load());
+        }
+        names.push_back("removed_param");
+        reordered.paramValues.push_back(0.5f);
+        reordered.layoutHash = PluginStateCodec::computeLayoutHash(names);
+        reordered.packedParamNames = PluginStateCodec::packParamNames(names);
+        reordered.uiStateJson = uiStateJson;
+
+        juce::MemoryBlock block;
+        PluginStateCodec::encode(reordered, block);
+        auto mismatchTarget = std::unique_ptr<juce::AudioProcessor>(createPluginFilter());
+        auto* typedMismatchTarget = dynamic_cast<PluginProcessor*>(mismatchTarget.get());
+        mismatchTarget->setStateInformation(block.getData(), (int)block.getSize());
+        if (!paramsMatch(*typedSource, *typedMismatchTarget) || typedMismatchTarget->getUiStateJson() != uiStateJson)
+        {
+            printf("FAIL: state with a different parameter layout was not restored by ID\n");
+            return 1;
+        }
+    }
+    printf("PASS: Layout mismatch restores parameters by ID\n");
+
+    // Every instance gets its own values, so each save encodes different data
+    // and each restore (shifted by one instance) changes real values.
+    std::vector<std::unique_ptr<juce::AudioProcessor>> session;
+    session.reserve(kInstanceCount);
+    for (int i = 0; i < kInstanceCount; ++i)
+    {
+        session.push_back(std::unique_ptr<juce::AudioProcessor>(createPluginFilter()));
+        const auto& sessionParams = session.back()->getParameters();
+        for (int p = 0; p < sessionParams.size(); ++p)
+            sessionParams[p]->setValueNotifyingHost((float)((p * 37 + i * 11) % 100) / 100.0f);
+        dynamic_cast<PluginProcessor*>(session.back().get())->setUiStateJson(uiStateJson);
+    }
+
+    std::vector<juce::MemoryBlock> binaryStates((size_t)kInstanceCount);
+    auto binaryStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < kInstanceCount; ++i)
+        session[(size_t)i]->getStateInformation(binaryStates[(size_t)i]);
+    for (int i = 0; i < kInstanceCount; ++i)
+        session[(size_t)((i + 1) % kInstanceCount)]->setStateInformation(binaryStates[(size_t)i].getData(),
+                                                                          (int)binaryStates[(size_t)i].getSize());
+    const double binaryMs = elapsedMs(binaryStart);
+
+    juce::MemoryBlock shifted;
+    session[1]->getStateInformation(shifted);
+    if (shifted != binaryStates[0])
+    {
+        printf("FAIL: instance 1 does not hold instance 0's state after the session restore\n");
+        return 1;
+    }
+
+    std::vector<juce::MemoryBlock> legacyStates((size_t)kInstanceCount);
+    auto legacyStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < kInstanceCount; ++i)
+        createLegacyXmlState(*dynamic_cast<PluginProcessor*>(session[(size_t)i].get()), uiStateJson,
+                             legacyStates[(size_t)i]);
+    for (int i = 0; i < kInstanceCount; ++i)
+        session[(size_t)i]->setStateInformation(legacyStates[(size_t)((i + 1) % kInstanceCount)].getData(),
+                                                (int)legacyStates[(size_t)((i + 1) % kInstanceCount)].getSize());
+    const double legacyMs = elapsedMs(legacyStart);
+
+    printf("INFO: save+restore x%d: binary %.2f ms, legacy xml %.2f ms\n", kInstanceCount, binaryMs, legacyMs);
+    printf("PASS: Save/restore timing measured\n");
+
+    printf("=== All plugin state checks passed ===\n");
+    return 0;
+}
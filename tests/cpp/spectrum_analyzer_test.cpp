@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "SpectrumAnalyzer.h"
+
+// Feeds a 1 kHz tone through the analyzer and checks that the published frame
+// peaks in the log-spaced band whose range holds 1 kHz.
+
+int main()
+{
+    printf("=== Spectrum Analyzer Test ===\n");
+    constexpr double kSampleRate = 48000.0;
+    constexpr double kToneHz = 1000.0;
+
+    SpectrumAnalyzer analyzer;
+    analyzer.prepare(kSampleRate);
+    analyzer.setActive(true);
+
+    juce::AudioBuffer<float> tone(2, 512);
+    for (int block = 0, t = 0; block < 8; ++block)
+    {
+        for (int i = 0; i < 512; ++i, ++t)
+        {
+            const float v = 0.5f * (float) std::sin(juce::MathConstants<double>::twoPi * kToneHz * t / kSampleRate);
+            tone.setSample(0, i, v);
+            tone.setSample(1, i, v);
+        }
+        analyzer.push(tone);
+    }
+
+    SpectrumAnalyzer::Frame frame {};
+    uint32_t sequence = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!analyzer.getFrameIfNewer(sequence, frame) && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if (sequence == 0)
+    {
+        printf("FAIL: spectrum analyzer produced no frame within 1 s\n");
+        return 1;
+    }
+
+    const auto peakBand = (int) (std::max_element(frame.begin(), frame.end()) - frame.begin());
+    const auto expectedBand = (int) std::floor(SpectrumAnalyzer::numBands
+                                              * std::log(kToneHz / SpectrumAnalyzer::minHz)
+                                              / std::log((double) SpectrumAnalyzer::maxHz / SpectrumAnalyzer::minHz));
+    if (std::abs(peakBand - expectedBand) > 1)
+    {
+        printf("FAIL: 1 kHz tone peaked in spectrum band %d, expected %d\n", peakBand, expectedBand);
+        return 1;
+    }
+    printf("PASS: Spectrum analyzer locates a 1 kHz tone (band %d)\n", peakBand);
+
+    printf("=== All spectrum analyzer tests passed ===\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <atomic>
+#include <cstdio>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "moonvst/Trace.h"
+
+// Records from more threads than there are rings and checks that extra
+// threads are counted as untraced, that rings of exited threads are handed
+// to new ones, and that the exported Chrome trace carries every event with
+// the id of the thread that recorded it.
+
+#if MOONVST_ENABLE_TRACE
+
+namespace
+{
+struct TraceCounts
+{
+    int held = 0;
+    int extra = 0;
+    int reused = 0;
+    int scoped = 0;
+    std::set<int> heldThreads;
+    int reusedThread = -1;
+    int untraced = -1;
+    int dropped = -1;
+};
+
+bool readTrace(const juce::File& file, TraceCounts& counts)
+{
+    const auto root = juce::JSON::parse(file);
+    const auto* events = root["traceEvents"].getArray();
+    if (events == nullptr)
+        return false;
+
+    for (const auto& event : *events)
+    {
+        const auto name = event["name"].toString();
+        const auto phase = event["ph"].toString();
+        const int thread = (int) event["tid"];
+        if (name == "held" && phase == "B")
+        {
+            ++counts.held;
+            counts.heldThreads.insert(thread);
+        }
+        else if (name == "extra")
+            ++counts.extra;
+        else if (name == "reused" && phase == "i")
+        {
+            ++counts.reused;
+            counts.reusedThread = thread;
+        }
+        else if (name == "scoped")
+            ++counts.scoped;
+        else if (name == "dropped_events")
+        {
+            counts.dropped = (int) event["args"]["count"];
+            counts.untraced = (int) event["args"]["untraced"];
+        }
+    }
+    return true;
+}
+}
+
+int main()
+{
+    printf("=== Trace Test ===\n");
+    namespace trace = moonvst::trace;
+
+    if (! trace::startCapture())
+    {
+        printf("FAIL: capture did not start\n");
+        return 1;
+    }
+    if (trace::startCapture())
+    {
+        printf("FAIL: a second capture started while one was running\n");
+        return 1;
+    }
+
+    // Lease every ring and hold it until the extra thread has tried to record.
+    std::atomic<int> leased { 0 };
+    std::atomic<bool> release { false };
+    std::vector<std::thread> holders;
+    for (int i = 0; i < trace::kMaxTracedThreads; ++i)
+    {
+        holders.emplace_back([&]
+        {
+            trace::begin("held");
+            ++leased;
+            while (! release.load())
+                std::this_thread::yield();
+            trace::end("held");
+        });
+    }
+    while (leased.load() < trace::kMaxTracedThreads)
+        std::this_thread::yield();
+
+    std::thread([] { trace::instant("extra"); }).join();
+
+    release.store(true);
+    for (auto& holder : holders)
+        holder.join();
+
+    // Every holder has exited, so this thread gets one of their rings.
+    std::thread([]
+    {
+        trace::instant("reused");
+        MOONVST_TRACE_SCOPE("scoped");
+    }).join();
+
+    const auto file = juce::File::createTempFile(".json");
+    if (! trace::stopCapture(file))
+    {
+        printf("FAIL: capture could not be written to %s\n", file.getFullPathName().toRawUTF8());
+        return 1;
+    }
+    if (trace::stopCapture(file))
+    {
+        printf("FAIL: stopCapture succeeded with no capture running\n");
+        return 1;
+    }
+
+    TraceCounts counts;
+    const bool parsed = readTrace(file, counts);
+    file.deleteFile();
+    if (! parsed)
+    {
+        printf("FAIL: exported trace has no traceEvents array\n");
+        return 1;
+    }
+
+    if (counts.held != trace::kMaxTracedThreads || (int) counts.heldThreads.size() != trace::kMaxTracedThreads)
+    {
+        printf("FAIL: expected %d held events on distinct threads, got %d on %d\n",
+               trace::kMaxTracedThreads, counts.held, (int) counts.heldThreads.size());
+        return 1;
+    }
+    printf("PASS: %d threads each recorded into their own ring\n", trace::kMaxTracedThreads);
+
+    if (counts.extra != 0 || counts.untraced != 1)
+    {
+        printf("FAIL: thread past the ring limit recorded %d events, %d counted untraced\n",
+               counts.extra, counts.untraced);
+        return 1;
+    }
+    printf("PASS: thread past the ring limit was counted as untraced\n");
+
+    if (counts.reused != 1 || counts.scoped != 2 || counts.heldThreads.count(counts.reusedThread) != 0)
+    {
+        printf("FAIL: thread started after the holders exited was not traced under its own id\n");
+        return 1;
+    }
+    printf("PASS: rings of exited threads are reused under a new thread id\n");
+
+    if (counts.dropped != 0)
+    {
+        printf("FAIL: %d events dropped\n", counts.dropped);
+        return 1;
+    }
+
+    printf("=== All trace tests passed ===\n");
+    return 0;
+}
+
+#else
+
+int main()
+{
+    printf("SKIP: tracing is compiled out (configure with -DMOONVST_ENABLE_TRACE=ON)\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "moonvst/WasmDSP.h"
+
+// Forces a trap into one of several WasmDSP instances and checks that the
+// block stays dry, only that instance is marked faulted, the shared watchdog
+// rebuilds it, and the rebuilt instance plays like a freshly prepared one.
+
+namespace
+{
+constexpr int kInstanceCount = 3;
+constexpr int kBlockSize = 64;
+constexpr double kSampleRate = 48000.0;
+constexpr int kRecoveryTimeoutMs = 5000;
+
+void fillInput(juce::AudioBuffer<float>& buffer)
+{
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(ch, i, 0.25f * std::sin(0.05f * (float) (i + 1)) * (ch == 0 ? 1.0f : -1.0f));
+}
+
+bool buffersMatch(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+{
+    for (int ch = 0; ch < a.getNumChannels(); ++ch)
+        for (int i = 0; i < a.getNumSamples(); ++i)
+            if (std::abs(a.getSample(ch, i) - b.getSample(ch, i)) > 1.0e-6f)
+                return false;
+    return true;
+}
+
+bool waitForRecovery(WasmDSP& dsp, uint32_t recoveries)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kRecoveryTimeoutMs);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        const auto health = dsp.getHealth();
+        if (! health.faulted && health.recoveries >= recoveries)
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+std::unique_ptr<WasmDSP> createPrepared()
+{
+    auto dsp = std::make_unique<WasmDSP>();
+    if (! dsp->initialize())
+        return nullptr;
+    dsp->setChannelLayout(2, 2);
+    dsp->prepare(kSampleRate, kBlockSize);
+    return dsp;
+}
+
+// Traps `victim`, checks the fault is contained and recovered from, and
+// returns false on the first failed check.
+bool trapAndRecover(std::vector<std::unique_ptr<WasmDSP>>& instances, int victim,
+                    const juce::AudioBuffer<float>& freshOutput)
+{
+    auto& dsp = *instances[(size_t) victim];
+    const auto before = dsp.getHealth();
+
+    dsp.forceTrapForTesting();
+    juce::AudioBuffer<float> input(2, kBlockSize);
+    fillInput(input);
+    juce::AudioBuffer<float> buffer(2, kBlockSize);
+    fillInput(buffer);
+    dsp.processBlock(buffer);
+
+    const auto faulted = dsp.getHealth();
+    if (! faulted.faulted || faulted.traps != before.traps + 1 || faulted.overruns != before.overruns)
+    {
+        printf("FAIL: trap not recorded (faulted %d, traps %u, overruns %u)\n",
+               faulted.faulted ? 1 : 0, faulted.traps, faulted.overruns);
+        return false;
+    }
+    if (! buffersMatch(buffer, input))
+    {
+        printf("FAIL: trapped block did not leave the dry input\n");
+        return false;
+    }
+    for (int i = 0; i < (int) instances.size(); ++i)
+    {
+        if (i != victim && instances[(size_t) i]->getHealth().faulted)
+        {
+            printf("FAIL: instance %d faulted alongside instance %d\n", i, victim);
+            return false;
+        }
+    }
+    printf("PASS: trap in instance %d left the block dry and faulted only that instance\n", victim);
+
+    if (! waitForRecovery(dsp, before.recoveries + 1))
+    {
+        printf("FAIL: instance %d was not rebuilt within %d ms\n", victim, kRecoveryTimeoutMs);
+        return false;
+    }
+
+    fillInput(buffer);
+    dsp.processBlock(buffer);
+    if (! buffersMatch(buffer, freshOutput) || dsp.getHealth().faulted)
+    {
+        printf("FAIL: rebuilt instance %d does not play like a fresh one\n", victim);
+        return false;
+    }
+    printf("PASS: instance %d rebuilt and plays like a fresh instance\n", victim);
+    return true;
+}
+}
+
+int main()
+{
+    printf("=== WasmDSP Recovery Test ===\n");
+
+    std::vector<std::unique_ptr<WasmDSP>> instances;
+    for (int i = 0; i < kInstanceCount; ++i)
+    {
+        auto dsp = createPrepared();
+        if (dsp == nullptr)
+        {
+            printf("SKIP: WasmDSP did not initialize (run build:dsp first)\n");
+            return 0;
+        }
+        instances.push_back(std::move(dsp));
+    }
+
+    // Every instance starts from the same state, so the first block of any of
+    // them is what a freshly rebuilt instance must reproduce.
+    juce::AudioBuffer<float> freshOutput(2, kBlockSize);
+    fillInput(freshOutput);
+    instances[0]->processBlock(freshOutput);
+    for (int i = 1; i < kInstanceCount; ++i)
+    {
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        fillInput(buffer);
+        instances[(size_t) i]->processBlock(buffer);
+    }
+
+    if (! trapAndRecover(instances, 1, freshOutput))
+        return 1;
+
+    // A second fault must count as a trap again, not as a leftover overrun.
+    if (! trapAndRecover(instances, 1, freshOutput))
+        return 1;
+
+    // The watchdog thread stops with the last instance and must come back
+    // for the next one.
+    instances.clear();
+    auto restarted = createPrepared();
+    if (restarted == nullptr)
+    {
+        printf("FAIL: WasmDSP did not initialize after every instance was destroyed\n");
+        return 1;
+    }
+    instances.push_back(std::move(restarted));
+    fillInput(freshOutput);
+    instances[0]->processBlock(freshOutput);
+    if (! trapAndRecover(instances, 0, freshOutput))
+        return 1;
+
+    const auto health = instances[0]->getHealth();
+    if (health.overruns != 0)
+    {
+        printf("FAIL: forced traps were counted as %u overruns\n", health.overruns);
+        return 1;
+    }
+
+    printf("=== All recovery tests passed ===\n");
+    return 0;
+}
@@ -151,13 +151,15 @@ int main()
         printf("PASS: init()/dsp_init() not exported (optional)\n");
     }
 
-    // 6.1 Call dsp_prepare(sampleRate)
+    // 6.1 Call dsp_prepare(sampleRate, maxBlockSize)
     if (fn_dsp_prepare != nullptr)
     {
         float sampleRate = 44100.0f;
-        uint32_t prepareArgs[1] = { 0 };
+        int32_t maxBlockSize = 512;
+        uint32_t prepareArgs[2] = { 0, 0 };
         std::memcpy(&prepareArgs[0], &sampleRate, sizeof(float));
-        if (!wasm_runtime_call_wasm(execEnv, fn_dsp_prepare, 1, prepareArgs))
+        std::memcpy(&prepareArgs[1], &maxBlockSize, sizeof(int32_t));
+        if (!wasm_runtime_call_wasm(execEnv, fn_dsp_prepare, 2, prepareArgs))
         {
             const char* ex = wasm_runtime_get_exception(inst);
             printf("FAIL: dsp_prepare() call failed%s%s\n", ex ? ": " : "", ex ? ex : "");
@@ -243,8 +245,8 @@ int main()
 
     // 9. Test process_block
     constexpr int NUM_SAMPLES = 4;
-    constexpr int INPUT_LEFT_OFFSET = moonvst::memory_layout::INPUT_LEFT_OFFSET;
-    constexpr int OUTPUT_LEFT_OFFSET = moonvst::memory_layout::OUTPUT_LEFT_OFFSET;
+    constexpr int INPUT_LEFT_OFFSET = moonvst::memory_layout::inputChannelOffset(0);
+    constexpr int OUTPUT_LEFT_OFFSET = moonvst::memory_layout::outputChannelOffset(0);
 
     uint8_t* wasmMem = (uint8_t*)wasm_runtime_addr_app_to_native(inst, 0);
     if (!wasmMem)
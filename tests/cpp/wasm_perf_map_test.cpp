@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "moonvst/WasmPerfMap.h"
+
+// Feeds hand-assembled modules to definedFunctionNames and checks that
+// imports are skipped, name-section names win over export names, names are
+// made perf-safe, and malformed modules yield no names.
+
+#if MOONVST_WASM_PERF_MAP
+
+namespace
+{
+using Bytes = std::vector<uint8_t>;
+
+// Every size and index below is under 128, so each LEB128 is one byte.
+void append(Bytes& out, const Bytes& bytes)
+{
+    out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+Bytes name(const std::string& text)
+{
+    Bytes out { (uint8_t) text.size() };
+    out.insert(out.end(), text.begin(), text.end());
+    return out;
+}
+
+Bytes section(uint8_t id, const Bytes& body)
+{
+    Bytes out { id, (uint8_t) body.size() };
+    append(out, body);
+    return out;
+}
+
+// Imports one function and one of every other kind, defines three functions
+// (indices 1-3), exports two of them and a memory, and optionally names two
+// of them in a name section.
+Bytes buildModule(bool withNameSection)
+{
+    Bytes module { 0x00, 'a', 's', 'm', 0x01, 0x00, 0x00, 0x00 };
+
+    append(module, section(1, { 0x01, 0x60, 0x00, 0x00 }));
+
+    Bytes imports { 0x05 };
+    append(imports, name("env"));
+    append(imports, name("host_log"));
+    append(imports, { 0x00, 0x00 });
+    append(imports, name("env"));
+    append(imports, name("table"));
+    append(imports, { 0x01, 0x70, 0x01, 0x01, 0x02 });
+    append(imports, name("env"));
+    append(imports, name("memory"));
+    append(imports, { 0x02, 0x00, 0x01 });
+    append(imports, name("env"));
+    append(imports, name("sp"));
+    append(imports, { 0x03, 0x7f, 0x01 });
+    append(imports, name("env"));
+    append(imports, name("tag"));
+    append(imports, { 0x04, 0x00, 0x00 });
+    append(module, section(2, imports));
+
+    append(module, section(3, { 0x03, 0x00, 0x00, 0x00 }));
+
+    Bytes exports { 0x03 };
+    append(exports, name("process_block"));
+    append(exports, { 0x00, 0x01 });
+    append(exports, name("tail"));
+    append(exports, { 0x00, 0x03 });
+    append(exports, name("memory"));
+    append(exports, { 0x02, 0x00 });
+    append(module, section(7, exports));
+
+    if (withNameSection)
+    {
+        Bytes names = name("name");
+        append(names, section(0, name("dsp")));
+        Bytes functionNames { 0x02, 0x02 };
+        append(functionNames, name("mix dry\twet"));
+        functionNames.push_back(0x03);
+        append(functionNames, name("process_reverb_sample"));
+        append(names, section(1, functionNames));
+        append(module, section(0, names));
+    }
+    return module;
+}
+
+bool expectNames(const char* label, const Bytes& module, const std::vector<std::string>& expected)
+{
+    const auto names = moonvst::perf_map::definedFunctionNames(module.data(), module.size());
+    if (names != expected)
+    {
+        printf("FAIL: %s: got %d names:", label, (int) names.size());
+        for (const auto& n : names)
+            printf(" '%s'", n.c_str());
+        printf("\n");
+        return false;
+    }
+    printf("PASS: %s\n", label);
+    return true;
+}
+}
+
+int main()
+{
+    printf("=== Wasm Perf Map Test ===\n");
+    bool ok = true;
+
+    ok &= expectNames("name section wins over exports, imports are skipped",
+                      buildModule(true), { "process_block", "mix_dry_wet", "process_reverb_sample" });
+
+    ok &= expectNames("stripped module falls back to export names",
+                      buildModule(false), { "process_block", "", "tail" });
+
+    auto truncated = buildModule(true);
+    truncated.pop_back();
+    ok &= expectNames("truncated section yields no names", truncated, {});
+
+    auto badMagic = buildModule(true);
+    badMagic[1] = 'b';
+    ok &= expectNames("wrong magic yields no names", badMagic, {});
+
+    auto badImportKind = buildModule(false);
+    const std::string field = "host_log";
+    const auto kind = std::search(badImportKind.begin(), badImportKind.end(), field.begin(), field.end()) + (long) field.size();
+    *kind = 0x09;
+    ok &= expectNames("unknown import kind yields no names", badImportKind, {});
+
+    if (! ok)
+        return 1;
+
+    printf("=== All perf map tests passed ===\n");
+    return 0;
+}
+
+#else
+
+int main()
+{
+    printf("SKIP: perf map support is compiled out (configure with -DMOONVST_WASM_PERF_MAP=ON on Linux)\n");
+    return 0;
+}
+
+#endif